@@ -41,9 +41,22 @@
 
 #include "stdafx.h"
 #include <stdio.h>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include "OcCommon.h"
 #include "ProgramOptions.h"
 #include "OcDbDatabase.h"
+#include "OcDbThumbnail.h"
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <dirent.h>
+#   include <sys/stat.h>
+#endif
 
 
 using namespace google;
@@ -77,6 +90,178 @@ const char* DefaultLogDir()
     return "";
 }
 
+void PrintReadStats(const OcDbReadStats & stats)
+{
+    printf("%-18s %10s %12s %8s %8s %12s\n",
+           "phase", "ms", "bytes", "seeks", "refills", "crc bytes");
+    for(int i = 0; i < OcDbReadStats::eNumPhases; ++i)
+    {
+        const OcDbReadStats::PhaseStats & ps = stats.phases[i];
+        printf("%-18s %10.3f %12llu %8llu %8llu %12llu\n",
+               OcDbReadStats::PhaseName((OcDbReadStats::Phase) i),
+               ps.seconds * 1000.0,
+               (unsigned long long) ps.bytes,
+               (unsigned long long) ps.seeks,
+               (unsigned long long) ps.refills,
+               (unsigned long long) ps.crcBytes);
+    }
+
+    if(stats.objectTypes.empty())
+    {
+        return;
+    }
+
+    printf("\n%-18s %10s %12s\n", "object type", "count", "bytes");
+    for(size_t type = 0; type < stats.objectTypes.size(); ++type)
+    {
+        const OcDbObjectTypeStats & ts = stats.objectTypes[type];
+        if(ts.count)
+        {
+            printf("%-18u %10u %12llu\n", (unsigned) type, ts.count,
+                   (unsigned long long) ts.bytes);
+        }
+    }
+}
+
+// Returns the .dwg files directly in sPath, or sPath itself when it
+// isn't a directory.
+std::vector<std::string> ListDrawings(const std::string & sPath)
+{
+    std::vector<std::string> drawings;
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(sPath.c_str());
+    if(attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+        drawings.push_back(sPath);
+        return drawings;
+    }
+
+    WIN32_FIND_DATAA fd;
+    HANDLE hFind = FindFirstFileA((sPath + "\\*.dwg").c_str(), &fd);
+    if(hFind != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if(!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            {
+                drawings.push_back(sPath + "\\" + fd.cFileName);
+            }
+        } while(FindNextFileA(hFind, &fd));
+        FindClose(hFind);
+    }
+#else
+    struct stat st;
+    if(stat(sPath.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+    {
+        drawings.push_back(sPath);
+        return drawings;
+    }
+
+    if(DIR * pDir = opendir(sPath.c_str()))
+    {
+        while(dirent * pEntry = readdir(pDir))
+        {
+            std::string sName(pEntry->d_name);
+            if(sName.size() > 4 && (sName.compare(sName.size() - 4, 4, ".dwg") == 0 ||
+                                    sName.compare(sName.size() - 4, 4, ".DWG") == 0))
+            {
+                drawings.push_back(sPath + "/" + sName);
+            }
+        }
+        closedir(pDir);
+    }
+#endif
+    return drawings;
+}
+
+// Writes the preview image of sDrawing to sOutDir, the bitmap if the
+// drawing has one, otherwise the metafile.
+OcApp::ErrorStatus WriteThumbnail(const std::string & sDrawing, const std::string & sOutDir)
+{
+    OcDbThumbnail thumbnail;
+    OcApp::ErrorStatus es = thumbnail.Read(sDrawing);
+    if(es != OcApp::eOk)
+    {
+        return es;
+    }
+
+    std::string sName = sDrawing.substr(sDrawing.find_last_of("/\\") + 1);
+    sName = sOutDir + "/" + sName.substr(0, sName.find_last_of('.'));
+
+    if(thumbnail.BmpSize() >= 40)
+    {
+        // The drawing stores a DIB, put the BITMAPFILEHEADER in front of
+        // it. Pixels follow the info header and the color table.
+        const uint8_t * pDib = thumbnail.BmpData();
+        auto u16 = [pDib](int i) { return (uint32_t)(pDib[i] | (pDib[i + 1] << 8)); };
+        auto u32 = [&u16](int i) { return u16(i) | (u16(i + 2) << 16); };
+        uint32_t bitCount = u16(14);
+        uint32_t colors = u32(32) ? u32(32) : (bitCount <= 8 ? 1u << bitCount : 0);
+        uint32_t masks = (u32(16) == 3) ? 12 : 0;   // BI_BITFIELDS
+        uint32_t fileSize = (uint32_t)(14 + thumbnail.BmpSize());
+        uint32_t pixels = 14 + u32(0) + masks + colors * 4;
+        const uint8_t fileHeader[14] =
+        {
+            'B', 'M',
+            (uint8_t) fileSize, (uint8_t)(fileSize >> 8), (uint8_t)(fileSize >> 16), (uint8_t)(fileSize >> 24),
+            0, 0, 0, 0,
+            (uint8_t) pixels, (uint8_t)(pixels >> 8), (uint8_t)(pixels >> 16), (uint8_t)(pixels >> 24),
+        };
+
+        std::ofstream fs((sName + ".bmp").c_str(), std::ios::out | std::ios::binary);
+        fs.write((const char *) fileHeader, sizeof(fileHeader));
+        fs.write((const char *) pDib, thumbnail.BmpSize());
+        return fs ? OcApp::eOk : OcApp::eOpeningFile;
+    }
+
+    if(thumbnail.WmfSize())
+    {
+        std::ofstream fs((sName + ".wmf").c_str(), std::ios::out | std::ios::binary);
+        fs.write((const char *) thumbnail.WmfData(), thumbnail.WmfSize());
+        return fs ? OcApp::eOk : OcApp::eOpeningFile;
+    }
+
+    return OcApp::eNotFound;
+}
+
+// Writes the thumbnails of all the drawings, one drawing per thread at
+// a time.
+int WriteThumbnails(const std::vector<std::string> & drawings, const std::string & sOutDir)
+{
+    std::atomic<size_t> next(0);
+    std::atomic<int> failed(0);
+    std::mutex printMutex;
+    std::vector<std::thread> workers;
+    size_t nThreads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                       drawings.size());
+
+    for(size_t i = 0; i < nThreads; ++i)
+    {
+        workers.push_back(std::thread([&]()
+        {
+            for(size_t n = next++; n < drawings.size(); n = next++)
+            {
+                OcApp::ErrorStatus es = WriteThumbnail(drawings[n], sOutDir);
+                if(es != OcApp::eOk)
+                {
+                    failed++;
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    printf("%s: no thumbnail written (error %d)\n", drawings[n].c_str(), (int) es);
+                }
+            }
+        }));
+    }
+
+    for(auto & worker : workers)
+    {
+        worker.join();
+    }
+
+    printf("%u of %u thumbnails written\n", (unsigned)(drawings.size() - failed),
+           (unsigned) drawings.size());
+    return failed ? 1 : 0;
+}
+
 int main(int argc, char * argv[])
 {
     OcLogger::Init();
@@ -95,8 +280,23 @@ int main(int argc, char * argv[])
             return 1;
         }
 
+        if(!po.thumbnails().empty())
+        {
+            return WriteThumbnails(ListDrawings(po.drawing()), po.thumbnails());
+        }
+
         OcDbDatabase db;
         db.ReadDwg(po.drawing());
+
+        if(po.dump_trace())
+        {
+            OcDbDatabase::DumpTrace(cout);
+        }
+
+        if(po.stats())
+        {
+            PrintReadStats(db.ReadStats());
+        }
     }
 #if defined(_WIN32) && !defined(NDEBUG)
     // Check for memory leaks in debug builds.
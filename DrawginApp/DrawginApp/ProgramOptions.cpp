@@ -46,6 +46,7 @@ using namespace std;
 BEGIN_OCTAVARIUM_NS
 
 ProgramOptions::ProgramOptions()
+    : m_bDumpTrace(false), m_bStats(false)
 {
 
 }
@@ -110,6 +111,16 @@ void ProgramOptions::ShowHelp()
     cout << "  --v=int                 Gives the default maximal active V-logging level." << endl;
     cout << "                          Defaults to 0" << endl;
     cout << "  --drawing=string        Input drawing file name (fullpath) to process." << endl;
+    cout << "                          With --thumbnails, may be a directory, every" << endl;
+    cout << "                          .dwg file in it is processed." << endl;
+    cout << "  --dump_trace=bool       Write the last decoded fields to stdout after reading" << endl;
+    cout << "                          the drawing. Needs a debug build, or one with" << endl;
+    cout << "                          OC_TRACE_BITSTREAM=1." << endl;
+    cout << "                          Defaults to 0" << endl;
+    cout << "  --stats                 Print timings and stream activity for each" << endl;
+    cout << "                          section of the drawing after reading it." << endl;
+    cout << "  --thumbnails=string     Only write the preview image of the drawing(s)" << endl;
+    cout << "                          to this directory, as name.bmp or name.wmf." << endl;
     cout << "  --version               Display version of this application." << endl;
 }
 
@@ -126,6 +137,11 @@ int ProgramOptions::Set( int argc, char * argv[] )
                 cout << "version " << version() << endl;
                 continue;
             }
+            else if(str == "--stats")
+            {
+                stats(true);
+                continue;
+            }
             else if(str == "--help")
             {
                 cout << "Usage: " << GetAppName(argv[0]) << " [options...]" << endl;
@@ -214,6 +230,16 @@ int ProgramOptions::Set( int argc, char * argv[] )
                 drawing(s2);
                 continue;
             }
+            if(s1 == "--dump_trace")
+            {
+                dump_trace(!!stoi(s2));
+                continue;
+            }
+            if(s1 == "--thumbnails")
+            {
+                thumbnails(s2);
+                continue;
+            }
 
             cout << str << endl;
             cout << "unrecognised option '" << str << "'" << endl;
@@ -375,4 +401,34 @@ void ProgramOptions::drawing( const std::string & val )
     m_sDrawing = val;
 }
 
+bool ProgramOptions::dump_trace( void )
+{
+    return m_bDumpTrace;
+}
+
+void ProgramOptions::dump_trace( bool val )
+{
+    m_bDumpTrace = val;
+}
+
+bool ProgramOptions::stats( void )
+{
+    return m_bStats;
+}
+
+void ProgramOptions::stats( bool val )
+{
+    m_bStats = val;
+}
+
+std::string ProgramOptions::thumbnails( void )
+{
+    return m_sThumbnails;
+}
+
+void ProgramOptions::thumbnails( const std::string & val )
+{
+    m_sThumbnails = val;
+}
+
 END_OCTAVARIUM_NS
\ No newline at end of file
@@ -96,8 +96,20 @@ public:
     std::string drawing(void);
     void drawing(const std::string & val);
 
+    bool dump_trace(void);
+    void dump_trace(bool val);
+
+    bool stats(void);
+    void stats(bool val);
+
+    std::string thumbnails(void);
+    void thumbnails(const std::string & val);
+
 private:
     std::string m_sDrawing;
+    bool m_bDumpTrace;
+    bool m_bStats;
+    std::string m_sThumbnails;
 
 };
 
@@ -0,0 +1,337 @@
+/**
+ *	@file
+ *  @brief Benchmarks the OcBsStreamIn bit code readers
+ *
+ *  Each operator>> overload reads a stream of values with a distribution like a drawing's. Reports time per value and bytes per second.
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include "OcError.h"
+#include "OcBsStreamIn.h"
+#include "BitWriter.h"
+
+USING_OCTAVARIUM_NS
+
+namespace
+{
+// values read per benchmark iteration
+const int numValues = 1 << 16;
+
+typedef std::mt19937 Random;
+
+bool Chance(Random & gen, double p)
+{
+    return std::uniform_real_distribution<double>(0.0, 1.0)(gen) < p;
+}
+
+int Uniform(Random & gen, int lo, int hi)
+{
+    return std::uniform_int_distribution<int>(lo, hi)(gen);
+}
+
+// Flags and counts are mostly zero or small, a few use the full range.
+int16_t ShortValue(Random & gen)
+{
+    if(Chance(gen, 0.4))
+    {
+        return 0;
+    }
+
+    if(Chance(gen, 0.1))
+    {
+        return 256;
+    }
+
+    return (int16_t)(Chance(gen, 0.8) ? Uniform(gen, 1, 255) : Uniform(gen, -32768, 32767));
+}
+
+int32_t LongValue(Random & gen)
+{
+    if(Chance(gen, 0.3))
+    {
+        return 0;
+    }
+
+    return Chance(gen, 0.7) ? Uniform(gen, 1, 255) : Uniform(gen, INT_MIN, INT_MAX);
+}
+
+// Scale factors and unit vectors are often exactly 0 or 1, coordinates
+// are anything.
+double DoubleValue(Random & gen)
+{
+    if(Chance(gen, 0.3))
+    {
+        return 0.0;
+    }
+
+    if(Chance(gen, 0.2))
+    {
+        return 1.0;
+    }
+
+    return std::uniform_real_distribution<double>(-1.0e4, 1.0e4)(gen);
+}
+
+std::wstring Name(Random & gen)
+{
+    static const wchar_t chars[] = L"ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_$-";
+    std::wstring name((size_t) Uniform(gen, 0, 31), L' ');
+
+    for(size_t i = 0; i < name.size(); ++i)
+    {
+        name[i] = chars[Uniform(gen, 0, (int)(sizeof(chars) / sizeof(chars[0])) - 2)];
+    }
+
+    return name;
+}
+
+void WriteB(BitWriter & w, Random & gen)
+{
+    w.B(Chance(gen, 0.3));
+}
+
+void WriteBB(BitWriter & w, Random & gen)
+{
+    w.BB(Uniform(gen, 0, 3));
+}
+
+void WriteBBBB(BitWriter & w, Random & gen)
+{
+    w.BBBB(Uniform(gen, 0, 15));
+}
+
+void WriteBS(BitWriter & w, Random & gen)
+{
+    w.BS(ShortValue(gen));
+}
+
+void WriteBL(BitWriter & w, Random & gen)
+{
+    w.BL(LongValue(gen));
+}
+
+void WriteBD(BitWriter & w, Random & gen)
+{
+    w.BD(DoubleValue(gen));
+}
+
+void Write2BD(BitWriter & w, Random & gen)
+{
+    w.BD(DoubleValue(gen));
+    w.BD(DoubleValue(gen));
+}
+
+// Points drawn in plan, z is mostly 0.
+void Write3BD(BitWriter & w, Random & gen)
+{
+    w.BD(DoubleValue(gen));
+    w.BD(DoubleValue(gen));
+    w.BD(Chance(gen, 0.9) ? 0.0 : DoubleValue(gen));
+}
+
+void WriteRC(BitWriter & w, Random & gen)
+{
+    w.RC((uint8_t) Uniform(gen, 0, 255));
+}
+
+void WriteRS(BitWriter & w, Random & gen)
+{
+    w.RS((int16_t) Uniform(gen, -32768, 32767));
+}
+
+void WriteRL(BitWriter & w, Random & gen)
+{
+    w.RL(Uniform(gen, INT_MIN, INT_MAX));
+}
+
+void WriteRD(BitWriter & w, Random & gen)
+{
+    w.RD(std::uniform_real_distribution<double>(-1.0e4, 1.0e4)(gen));
+}
+
+void WriteRD2(BitWriter & w, Random & gen)
+{
+    WriteRD(w, gen);
+    WriteRD(w, gen);
+}
+
+void WriteRD3(BitWriter & w, Random & gen)
+{
+    WriteRD(w, gen);
+    WriteRD(w, gen);
+    WriteRD(w, gen);
+}
+
+// Object map offsets, mostly a few hundred bytes forward, sometimes back.
+void WriteMC(BitWriter & w, Random & gen)
+{
+    int32_t offset = Uniform(gen, 1, 1 << 13);
+    w.MC(Chance(gen, 0.1) ? -offset : offset);
+}
+
+// Object sizes.
+void WriteMS(BitWriter & w, Random & gen)
+{
+    w.MS((uint32_t)(Chance(gen, 0.95) ? Uniform(gen, 20, 2000) : Uniform(gen, 2000, 1 << 20)));
+}
+
+void WriteT(BitWriter & w, Random & gen)
+{
+    w.T(Name(gen));
+}
+
+void WriteTU(BitWriter & w, Random & gen)
+{
+    w.TU(Name(gen));
+}
+
+// R2000 colors are only an index.
+void WriteCMC(BitWriter & w, Random & gen)
+{
+    w.BS((int16_t)(Chance(gen, 0.5) ? 256 : Uniform(gen, 0, 255)));
+}
+
+// R2004 colors add a true color, and sometimes a name.
+void WriteCMC2004(BitWriter & w, Random & gen)
+{
+    WriteCMC(w, gen);
+    w.BL(Uniform(gen, 0, 0xffffff) | (0xc2 << 24));
+    uint8_t colorByte = (uint8_t)(Chance(gen, 0.1) ? 3 : 0);
+    w.RC(colorByte);
+
+    if(colorByte & 1)
+    {
+        w.T(Name(gen));
+    }
+
+    if(colorByte & 2)
+    {
+        w.T(Name(gen));
+    }
+}
+
+// Soft and hard pointer codes, handles of a large drawing.
+void WriteHandle(BitWriter & w, Random & gen)
+{
+    w.Handle(Uniform(gen, 2, 5), (uint64_t) Uniform(gen, 0, 1 << 20));
+}
+
+template<typename BC>
+void ReadValues(OcBsStreamIn & in)
+{
+    BC value;
+
+    for(int i = 0; i < numValues; ++i)
+    {
+        in >> value;
+    }
+
+    benchmark::DoNotOptimize(value);
+}
+
+// Writes numValues values with write, then times reading them back with
+// read from a memory buffer.
+void BM_Read(benchmark::State & state, void (*write)(BitWriter &, Random &),
+             void (*read)(OcBsStreamIn &), DWG_VERSION version)
+{
+    Random gen(5489u);
+    BitWriter writer;
+
+    for(int i = 0; i < numValues; ++i)
+    {
+        write(writer, gen);
+    }
+
+    // ReadBits loads 8 bytes at a time, keep the last values in bounds.
+    std::vector<uint8_t> bytes = writer.Bytes();
+    bytes.resize(bytes.size() + sizeof(uint64_t));
+
+    OcBsStreamIn in(bytes.data(), bytes.size());
+    in.SetVersion(version);
+
+    for(auto _ : state)
+    {
+        in.Seek(0);
+        read(in);
+    }
+
+    if(in.FilePosition() != (std::streamoff)(writer.BitSize() / 8))
+    {
+        state.SkipWithError("read a different number of bits than written");
+        return;
+    }
+
+    state.SetBytesProcessed(state.iterations() * (int64_t) writer.ByteSize());
+    state.counters["time/value"] = benchmark::Counter(
+                                       numValues,
+                                       benchmark::Counter::kIsIterationInvariantRate |
+                                       benchmark::Counter::kInvert);
+}
+}
+
+BENCHMARK_CAPTURE(BM_Read, B,         WriteB,       ReadValues<bitcode::B>,      R2000);
+BENCHMARK_CAPTURE(BM_Read, BB,        WriteBB,      ReadValues<bitcode::BB>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, BBBB,      WriteBBBB,    ReadValues<bitcode::BBBB>,   R2000);
+BENCHMARK_CAPTURE(BM_Read, BS,        WriteBS,      ReadValues<bitcode::BS>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, BL,        WriteBL,      ReadValues<bitcode::BL>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, BD,        WriteBD,      ReadValues<bitcode::BD>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, 2BD,       Write2BD,     ReadValues<bitcode::BD2>,    R2000);
+BENCHMARK_CAPTURE(BM_Read, 3BD,       Write3BD,     ReadValues<bitcode::BD3>,    R2000);
+BENCHMARK_CAPTURE(BM_Read, BE_R14,    Write3BD,     ReadValues<bitcode::BE>,     R14);
+BENCHMARK_CAPTURE(BM_Read, BT_R14,    WriteBD,      ReadValues<bitcode::BT>,     R14);
+BENCHMARK_CAPTURE(BM_Read, RC,        WriteRC,      ReadValues<bitcode::RC>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, RS,        WriteRS,      ReadValues<bitcode::RS>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, RL,        WriteRL,      ReadValues<bitcode::RL>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, RD,        WriteRD,      ReadValues<bitcode::RD>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, RD2,       WriteRD2,     ReadValues<bitcode::RD2>,    R2000);
+BENCHMARK_CAPTURE(BM_Read, RD3,       WriteRD3,     ReadValues<bitcode::RD3>,    R2000);
+BENCHMARK_CAPTURE(BM_Read, MC,        WriteMC,      ReadValues<bitcode::MC>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, MS,        WriteMS,      ReadValues<bitcode::MS>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, T,         WriteT,       ReadValues<bitcode::T>,      R2000);
+BENCHMARK_CAPTURE(BM_Read, TV,        WriteT,       ReadValues<bitcode::TV>,     R2000);
+BENCHMARK_CAPTURE(BM_Read, TU,        WriteTU,      ReadValues<bitcode::TU>,     R2007);
+BENCHMARK_CAPTURE(BM_Read, CMC,       WriteCMC,     ReadValues<bitcode::CMC>,    R2000);
+BENCHMARK_CAPTURE(BM_Read, CMC_R2004, WriteCMC2004, ReadValues<bitcode::CMC>,    R2004);
+BENCHMARK_CAPTURE(BM_Read, H,         WriteHandle,  ReadValues<OcDbObjectId>,    R2000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,279 @@
+/**
+ *	@file
+ *  @brief Defines BitWriter class
+ *
+ *  Writes drawing bit codes, the inverse of OcBsStreamIn. Used to make input for the benchmarks.
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ *  Appends bit codes to a byte vector, most significant bit first, the
+ *  way OcBsStreamIn reads them. Each code is written in its shortest
+ *  form, as AutoCAD does.
+ */
+class BitWriter
+{
+public:
+    BitWriter() : m_bitPosition(0) {}
+
+    const std::vector<uint8_t> & Bytes() const
+    {
+        return m_bytes;
+    }
+
+    size_t ByteSize() const
+    {
+        return m_bytes.size();
+    }
+
+    uint64_t BitSize() const
+    {
+        return m_bytes.size() * 8 - (m_bitPosition ? 8 - m_bitPosition : 0);
+    }
+
+    // Writes the low nBits (1 - 64) of value, most significant first.
+    void WriteBits(uint64_t value, int nBits)
+    {
+        while(nBits > 0)
+        {
+            if(m_bitPosition == 0)
+            {
+                m_bytes.push_back(0);
+            }
+
+            int room = 8 - m_bitPosition;
+            int n = nBits < room ? nBits : room;
+            uint8_t chunk = (uint8_t)((value >> (nBits - n)) & ((1u << n) - 1));
+            m_bytes.back() |= (uint8_t)(chunk << (room - n));
+            m_bitPosition = (m_bitPosition + n) % 8;
+            nBits -= n;
+        }
+    }
+
+    void AlignByte()
+    {
+        m_bitPosition = 0;
+    }
+
+    // Overwrites a byte already written, for sizes and crcs known late.
+    void PatchByte(size_t offset, uint8_t value)
+    {
+        m_bytes[offset] = value;
+    }
+
+    void B(bool b)
+    {
+        WriteBits(b ? 1 : 0, 1);
+    }
+
+    void BB(int bb)
+    {
+        WriteBits((uint64_t) bb, 2);
+    }
+
+    void BBBB(int bbbb)
+    {
+        WriteBits((uint64_t) bbbb, 4);
+    }
+
+    void RC(uint8_t rc)
+    {
+        WriteBits(rc, 8);
+    }
+
+    void RS(int16_t rs)
+    {
+        RC((uint8_t) rs);
+        RC((uint8_t)((uint16_t) rs >> 8));
+    }
+
+    void RL(int32_t rl)
+    {
+        RS((int16_t) rl);
+        RS((int16_t)((uint32_t) rl >> 16));
+    }
+
+    void RD(double rd)
+    {
+        uint64_t bits;
+        memcpy(&bits, &rd, sizeof(bits));
+        RL((int32_t) bits);
+        RL((int32_t)(bits >> 32));
+    }
+
+    void BS(int16_t bs)
+    {
+        if(bs == 0)
+        {
+            WriteBits(2, 2);
+        }
+        else if(bs == 256)
+        {
+            WriteBits(3, 2);
+        }
+        else if(bs > 0 && bs < 256)
+        {
+            WriteBits(1, 2);
+            RC((uint8_t) bs);
+        }
+        else
+        {
+            WriteBits(0, 2);
+            RS(bs);
+        }
+    }
+
+    void BL(int32_t bl)
+    {
+        if(bl == 0)
+        {
+            WriteBits(2, 2);
+        }
+        else if(bl > 0 && bl < 256)
+        {
+            WriteBits(1, 2);
+            RC((uint8_t) bl);
+        }
+        else
+        {
+            WriteBits(0, 2);
+            RL(bl);
+        }
+    }
+
+    void BD(double bd)
+    {
+        if(bd == 0.0)
+        {
+            WriteBits(2, 2);
+        }
+        else if(bd == 1.0)
+        {
+            WriteBits(1, 2);
+        }
+        else
+        {
+            WriteBits(0, 2);
+            RD(bd);
+        }
+    }
+
+    // Seven bits per byte, low group first. The high bit of a byte says
+    // another follows, bit 0x40 of the last one is the sign.
+    void MC(int32_t mc)
+    {
+        bool bNeg = mc < 0;
+        uint32_t value = bNeg ? 0u - (uint32_t) mc : (uint32_t) mc;
+
+        while(value >= 0x40)
+        {
+            RC((uint8_t)(0x80 | (value & 0x7f)));
+            value >>= 7;
+        }
+
+        RC((uint8_t)(value | (bNeg ? 0x40 : 0)));
+    }
+
+    // Fifteen bits per little endian word, the high bit says another
+    // word follows.
+    void MS(uint32_t ms)
+    {
+        while(ms >= 0x8000)
+        {
+            RS((int16_t)(0x8000 | (ms & 0x7fff)));
+            ms >>= 15;
+        }
+
+        RS((int16_t) ms);
+    }
+
+    // 8 bit text of R2004 and earlier drawings.
+    void T(const std::wstring & t)
+    {
+        BS((int16_t) t.size());
+
+        for(size_t i = 0; i < t.size(); ++i)
+        {
+            RC((uint8_t) t[i]);
+        }
+    }
+
+    // Unicode text of R2007 and later drawings.
+    void TU(const std::wstring & tu)
+    {
+        BS((int16_t) tu.size());
+
+        for(size_t i = 0; i < tu.size(); ++i)
+        {
+            RS((int16_t) tu[i]);
+        }
+    }
+
+    // The handle bytes are stored most significant first, as few as
+    // the value needs.
+    void Handle(int code, uint64_t handle)
+    {
+        int counter = 0;
+
+        for(uint64_t h = handle; h; h >>= 8)
+        {
+            ++counter;
+        }
+
+        WriteBits((uint64_t)((code << 4) | counter), 8);
+
+        for(int i = counter - 1; i >= 0; --i)
+        {
+            RC((uint8_t)(handle >> (i * 8)));
+        }
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    int m_bitPosition;
+};
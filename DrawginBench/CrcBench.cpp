@@ -0,0 +1,98 @@
+/**
+ *	@file
+ *  @brief Benchmarks the drawing CRC kernels
+ *
+ *  Reports bytes per second of crc8 and crc8Span over random data.
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include "OcBsDwgCrc.h"
+
+USING_OCTAVARIUM_NS
+
+namespace
+{
+std::vector<byte_t> RandomBytes(size_t n)
+{
+    std::mt19937 gen(0x0c0c1);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<byte_t> bytes(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        bytes[i] = (byte_t) dist(gen);
+    }
+    return bytes;
+}
+
+void BM_crc8(benchmark::State & state)
+{
+    std::vector<byte_t> bytes = RandomBytes((size_t) state.range(0));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc8(0xc0c1, (const char *) bytes.data(),
+                                      (long) bytes.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t) bytes.size());
+}
+
+void BM_crc8Span(benchmark::State & state)
+{
+    std::vector<byte_t> bytes = RandomBytes((size_t) state.range(0));
+    if(crc8Span(0xc0c1, bytes.data(), bytes.size()) !=
+            crc8(0xc0c1, (const char *) bytes.data(), (long) bytes.size()))
+    {
+        state.SkipWithError("crc8Span does not match crc8");
+        return;
+    }
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc8Span(0xc0c1, bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t) bytes.size());
+}
+}
+
+BENCHMARK(BM_crc8)->RangeMultiplier(16)->Range(16, 64 << 20);
+BENCHMARK(BM_crc8Span)->RangeMultiplier(16)->Range(16, 64 << 20);
+
+BENCHMARK_MAIN();
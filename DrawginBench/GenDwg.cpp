@@ -0,0 +1,169 @@
+/**
+ *	@file
+ *  @brief Defines the entry point for the GenDwg tool
+ *
+ *  Writes synthetic drawings of a chosen size for benchmarking.
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "OcError.h"
+#include "OcDbDatabase.h"
+#include "SyntheticDwg.h"
+
+USING_OCTAVARIUM_NS
+
+namespace
+{
+void ShowHelp()
+{
+    std::cout << "Usage: GenDwg [options...] --drawing=string" << std::endl;
+    std::cout << " Options:" << std::endl;
+    std::cout << "  --help                  display this help and exit." << std::endl;
+    std::cout << "  --drawing=string        Output drawing file name." << std::endl;
+    std::cout << "  --version=string        R13, R14 or R2000. Defaults to R2000" << std::endl;
+    std::cout << "  --objects=int           Number of objects. Defaults to 50000" << std::endl;
+    std::cout << "  --classes=int           Number of classes. Defaults to 20" << std::endl;
+    std::cout << "  --object_size=int       Bytes of each object. Defaults to 48" << std::endl;
+    std::cout << "  --string_length=int     Characters of header and class strings." << std::endl;
+    std::cout << "                          Defaults to 16" << std::endl;
+    std::cout << "  --preview_size=int      Bytes of the preview image. Defaults to 4096" << std::endl;
+}
+} // namespace
+
+/**
+ *  Writes a synthetic drawing made by MakeSyntheticDwg, then reads it back
+ *  with OcDbDatabase::ReadDwg to check the library accepts it.
+ */
+int main(int argc, char * argv[])
+{
+    SyntheticDwgOptions options;
+    std::string sDrawing;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string str(argv[i]);
+        size_t pos = str.find('=');
+
+        if(str == "--help" || pos == std::string::npos)
+        {
+            ShowHelp();
+            return str == "--help" ? 0 : 1;
+        }
+
+        std::string s1 = str.substr(0, pos);
+        std::string s2 = str.substr(pos + 1);
+
+        try
+        {
+            if(s1 == "--drawing")
+            {
+                sDrawing = s2;
+            }
+            else if(s1 == "--version")
+            {
+                options.version = s2 == "R13" ? R13 : (s2 == "R14" ? R14 : (s2 == "R2000" ? R2000 : NONE));
+
+                if(options.version == NONE)
+                {
+                    std::cout << "unsupported version '" << s2 << "'" << std::endl;
+                    return 1;
+                }
+            }
+            else if(s1 == "--objects")
+            {
+                options.numObjects = std::stoi(s2);
+            }
+            else if(s1 == "--classes")
+            {
+                options.numClasses = std::stoi(s2);
+            }
+            else if(s1 == "--object_size")
+            {
+                options.objectSize = std::stoi(s2);
+            }
+            else if(s1 == "--string_length")
+            {
+                options.stringLength = std::stoi(s2);
+            }
+            else if(s1 == "--preview_size")
+            {
+                options.previewSize = std::stoi(s2);
+            }
+            else
+            {
+                std::cout << "unrecognised option '" << str << "'" << std::endl;
+                return 1;
+            }
+        }
+        catch(const std::exception &)
+        {
+            std::cout << "the argument ('" << s2 << "') for option '" << s1 << "' is invalid" << std::endl;
+            return 1;
+        }
+    }
+
+    if(sDrawing.empty())
+    {
+        ShowHelp();
+        return 1;
+    }
+
+    std::vector<byte_t> dwg = MakeSyntheticDwg(options);
+    std::ofstream file(sDrawing.c_str(), std::ios::binary);
+    file.write((const char *) &dwg[0], dwg.size());
+    file.close();
+
+    if(!file)
+    {
+        std::cout << "could not write " << sDrawing << std::endl;
+        return 1;
+    }
+
+    OcDbDatabase db;
+    OcApp::ErrorStatus es = db.ReadDwg(sDrawing);
+    std::cout << sDrawing << ": " << dwg.size() << " bytes, "
+              << options.numObjects << " objects, ReadDwg returned " << es << std::endl;
+    return es == OcApp::eOk ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+/**
+ *	@file
+ *  @brief Benchmarks OcDbDatabase::ReadDwg
+ *
+ *  Reports time and peak heap of reading synthetic drawings of 1,000 to 200,000 objects.
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <new>
+#include "OcError.h"
+#include "OcDbDatabase.h"
+#include "SyntheticDwg.h"
+
+USING_OCTAVARIUM_NS
+
+// Heap bytes in use, and the most in use since the last ResetPeak. Every
+// allocation carries its size in front of it so delete can subtract it.
+namespace
+{
+std::atomic<int64_t> heapInUse(0);
+std::atomic<int64_t> heapPeak(0);
+const size_t heapHeader = 16;
+
+void * Allocate(size_t size)
+{
+    void * p = std::malloc(size + heapHeader);
+
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+
+    *(size_t *) p = size;
+    int64_t inUse = heapInUse += (int64_t) size;
+    int64_t peak = heapPeak;
+
+    while(inUse > peak && !heapPeak.compare_exchange_weak(peak, inUse))
+    {
+    }
+
+    return (char *) p + heapHeader;
+}
+
+void Free(void * p)
+{
+    if(p)
+    {
+        void * block = (char *) p - heapHeader;
+        heapInUse -= (int64_t) *(size_t *) block;
+        std::free(block);
+    }
+}
+
+void ResetPeak()
+{
+    heapPeak = heapInUse.load();
+}
+} // namespace
+
+void * operator new(size_t size)
+{
+    return Allocate(size);
+}
+
+void * operator new[](size_t size)
+{
+    return Allocate(size);
+}
+
+void operator delete(void * p) noexcept
+{
+    Free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    Free(p);
+}
+
+void operator delete(void * p, size_t /*size*/) noexcept
+{
+    Free(p);
+}
+
+void operator delete[](void * p, size_t /*size*/) noexcept
+{
+    Free(p);
+}
+
+namespace
+{
+// Drawings are generated once per shape and removed at exit.
+class DrawingFiles
+{
+public:
+    ~DrawingFiles()
+    {
+        for(auto & file : m_files)
+        {
+            std::remove(file.second.c_str());
+        }
+    }
+
+    const std::string & Get(DWG_VERSION version, int numObjects)
+    {
+        std::string & sFilename = m_files[std::make_pair(version, numObjects)];
+
+        if(sFilename.empty())
+        {
+            SyntheticDwgOptions options;
+            options.version = version;
+            options.numObjects = numObjects;
+            std::vector<byte_t> dwg = MakeSyntheticDwg(options);
+            sFilename = "ReadDwgBench_" + OcBsDwgVersion::GetVersionId(version) + "_" +
+                        std::to_string(numObjects) + ".dwg";
+            std::ofstream file(sFilename.c_str(), std::ios::binary);
+            file.write((const char *) &dwg[0], dwg.size());
+        }
+
+        return sFilename;
+    }
+
+private:
+    std::map<std::pair<DWG_VERSION, int>, std::string> m_files;
+};
+
+DrawingFiles drawingFiles;
+
+// Where ReadDwg reads the drawing from
+enum Source { eMappedFile, eFileStream, eMemory, };
+
+// range(0) is the number of objects, range(1) the DWG_VERSION. peak_heap
+// is the most heap a read used on top of what was in use before it.
+void BM_ReadDwg(benchmark::State & state, OcDbDatabase::ReadMode mode, Source source)
+{
+    int numObjects = (int) state.range(0);
+    DWG_VERSION version = (DWG_VERSION) state.range(1);
+    const std::string & sFilename = drawingFiles.Get(version, numObjects);
+
+    std::vector<byte_t> dwg;
+
+    if(source == eMemory)
+    {
+        std::ifstream file(sFilename.c_str(), std::ios::binary);
+        dwg.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    int64_t peak = 0;
+
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        std::unique_ptr<OcDbDatabase> pDb(new OcDbDatabase);
+        pDb->SetFileAccess(source == eFileStream ? OcDbDatabase::eFileStream
+                                                 : OcDbDatabase::eMapFile);
+        int64_t inUse = heapInUse;
+        ResetPeak();
+        state.ResumeTiming();
+
+        OcApp::ErrorStatus es = source == eMemory ? pDb->ReadDwg(&dwg[0], dwg.size(), mode)
+                                : pDb->ReadDwg(sFilename, mode);
+
+        state.PauseTiming();
+        peak = std::max<int64_t>(peak, heapPeak - inUse);
+
+        if(es != OcApp::eOk)
+        {
+            state.SkipWithError("ReadDwg failed");
+        }
+
+        pDb.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * numObjects);
+    state.counters["peak_heap"] = benchmark::Counter((double) peak, benchmark::Counter::kDefaults,
+                                                     benchmark::Counter::OneK::kIs1024);
+}
+
+void Shapes(benchmark::internal::Benchmark * b)
+{
+    for(int version : { R14, R2000 })
+    {
+        for(int numObjects : { 1000, 10000, 50000, 200000 })
+        {
+            b->Args({ numObjects, version });
+        }
+    }
+
+    b->ArgNames({ "objects", "version" })->Unit(benchmark::kMillisecond);
+}
+} // namespace
+
+BENCHMARK_CAPTURE(BM_ReadDwg, File, OcDbDatabase::eReadAll, eMappedFile)->Apply(Shapes);
+BENCHMARK_CAPTURE(BM_ReadDwg, FileLazy, OcDbDatabase::eReadLazy, eMappedFile)->Apply(Shapes);
+BENCHMARK_CAPTURE(BM_ReadDwg, Stream, OcDbDatabase::eReadAll, eFileStream)->Apply(Shapes);
+BENCHMARK_CAPTURE(BM_ReadDwg, StreamLazy, OcDbDatabase::eReadLazy, eFileStream)->Apply(Shapes);
+BENCHMARK_CAPTURE(BM_ReadDwg, Memory, OcDbDatabase::eReadAll, eMemory)->Apply(Shapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,833 @@
+/**
+ *	@file
+ *  @brief Defines MakeSyntheticDwg
+ *
+ *  Makes R13 to R2000 drawings of any size for the ReadDwg benchmark and the GenDwg tool.
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "OcBsTypes.h"
+#include "OcBsDwgCrc.h"
+#include "OcBsDwgSentinels.h"
+#include "OcBsDwgVersion.h"
+#include "BitWriter.h"
+
+/**
+ *  Shape of a drawing made by MakeSyntheticDwg.
+ */
+struct SyntheticDwgOptions
+{
+    SyntheticDwgOptions()
+        : version(octavarium::R2000), numObjects(50000), numClasses(20),
+          objectSize(48), stringLength(16), previewSize(4096) {}
+
+    octavarium::DWG_VERSION version;    // R13, R14 or R2000
+    int numObjects;                     // entries in the object map
+    int numClasses;                     // custom classes, object types 500 and up
+    int objectSize;                     // bytes of each object after its size
+    int stringLength;                   // characters of header and class strings
+    int previewSize;                    // bytes of the preview bitmap
+};
+
+namespace synthetic_dwg
+{
+enum Code { eB, eBS, eBL, eBD, eBD3, eRC, eRD2, eT, eTV, eCMC, eH, };
+
+struct HeaderVar
+{
+    Code code;
+    const char * name;
+    octavarium::DWG_VERSION first;
+    octavarium::DWG_VERSION last;
+};
+
+// Header variables of R13 to R2000 drawings in file order, the same list
+// OcBsDatabaseHeaderVars::ReadDwg reads. cpsnid is left out, it is only
+// present when cepsntype is 3 and cepsntype is always written as 0.
+const HeaderVar headerVars[] =
+{
+    { eBD,   "unknown1",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "unknown2",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "unknown3",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "unknown4",                   octavarium::R13, octavarium::R2010 },
+    { eTV,   "unknown5",                   octavarium::R13, octavarium::R2010 },
+    { eTV,   "unknown6",                   octavarium::R13, octavarium::R2010 },
+    { eTV,   "unknown7",                   octavarium::R13, octavarium::R2010 },
+    { eTV,   "unknown8",                   octavarium::R13, octavarium::R2010 },
+    { eBL,   "unknown9",                   octavarium::R13, octavarium::R2010 },
+    { eBL,   "unknown10",                  octavarium::R13, octavarium::R2010 },
+    { eBS,   "unknown11",                  octavarium::R13, octavarium::R14 },
+    { eH,    "currentVpId",                octavarium::R13, octavarium::R2010 },
+    { eB,    "dimaso",                     octavarium::R13, octavarium::R2010 },
+    { eB,    "dimsho",                     octavarium::R13, octavarium::R2010 },
+    { eB,    "dimsav",                     octavarium::R13, octavarium::R14 },
+    { eB,    "plinegen",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "orthomode",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "regenmode",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "fillmode",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "qtextmode",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "psltscale",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "limcheck",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "blipmode",                   octavarium::R13, octavarium::R14 },
+    { eB,    "usertimer",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "skpoly",                     octavarium::R13, octavarium::R2010 },
+    { eB,    "angdir",                     octavarium::R13, octavarium::R2010 },
+    { eB,    "splframe",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "attreq",                     octavarium::R13, octavarium::R14 },
+    { eB,    "attdia",                     octavarium::R13, octavarium::R14 },
+    { eB,    "mirrtext",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "worldview",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "wireframe",                  octavarium::R13, octavarium::R14 },
+    { eB,    "tilemode",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "plimcheck",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "visretain",                  octavarium::R13, octavarium::R2010 },
+    { eB,    "delobj",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dispsilh",                   octavarium::R13, octavarium::R2010 },
+    { eB,    "pellipse",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "saveimages",                 octavarium::R13, octavarium::R2010 },
+    { eBS,   "dimsav",                     octavarium::R13, octavarium::R14 },
+    { eBS,   "treedepth",                  octavarium::R13, octavarium::R2010 },
+    { eBS,   "lunits",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "luprec",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "aunits",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "auprec",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "osmode",                     octavarium::R13, octavarium::R14 },
+    { eBS,   "attmode",                    octavarium::R13, octavarium::R2010 },
+    { eBS,   "coords",                     octavarium::R13, octavarium::R14 },
+    { eBS,   "pdmode",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "pickstyle",                  octavarium::R13, octavarium::R14 },
+    { eBS,   "useri1",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "useri2",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "useri3",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "useri4",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "useri5",                     octavarium::R13, octavarium::R2010 },
+    { eBS,   "splinesegs",                 octavarium::R13, octavarium::R2010 },
+    { eBS,   "surfu",                      octavarium::R13, octavarium::R2010 },
+    { eBS,   "surfv",                      octavarium::R13, octavarium::R2010 },
+    { eBS,   "surftype",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "surftab1",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "surftab2",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "splinetype",                 octavarium::R13, octavarium::R2010 },
+    { eBS,   "shadedge",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "shadedif",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "unitmode",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "maxactvp",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "isolines",                   octavarium::R13, octavarium::R2010 },
+    { eBS,   "cmljust",                    octavarium::R13, octavarium::R2010 },
+    { eBS,   "textqlty",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "ltscale",                    octavarium::R13, octavarium::R2010 },
+    { eBD,   "textsize",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "tracewid",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "sketchinc",                  octavarium::R13, octavarium::R2010 },
+    { eBD,   "filletrad",                  octavarium::R13, octavarium::R2010 },
+    { eBD,   "thickness",                  octavarium::R13, octavarium::R2010 },
+    { eBD,   "angbase",                    octavarium::R13, octavarium::R2010 },
+    { eBD,   "pdsize",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "plinewid",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "userr1",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "userr2",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "userr3",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "userr4",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "userr5",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "chamfera",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "chamferb",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "chamferc",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "chamferd",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "facetres",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "cmlscale",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "celtscale",                  octavarium::R13, octavarium::R2010 },
+    { eTV,   "menuname",                   octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdcreate_day",               octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdcreate_ms",                octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdupdate_day",               octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdupdate_ms",                octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdindwg_days",               octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdindwg_ms",                 octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdusrtimer_days",            octavarium::R13, octavarium::R2010 },
+    { eBL,   "tdusrtimer_ms",              octavarium::R13, octavarium::R2010 },
+    { eCMC,  "cecolor",                    octavarium::R13, octavarium::R2010 },
+    { eH,    "handseed",                   octavarium::R13, octavarium::R2010 },
+    { eH,    "clayer",                     octavarium::R13, octavarium::R2010 },
+    { eH,    "textstyle",                  octavarium::R13, octavarium::R2010 },
+    { eH,    "celtype",                    octavarium::R13, octavarium::R2010 },
+    { eH,    "dimstyle",                   octavarium::R13, octavarium::R2010 },
+    { eH,    "cmlstyle",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "psvpscale",                  octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pinsbase",                   octavarium::R13, octavarium::R2010 },
+    { eBD3,  "pextmin",                    octavarium::R13, octavarium::R2010 },
+    { eBD3,  "pextmax",                    octavarium::R13, octavarium::R2010 },
+    { eRD2,  "plimmin",                    octavarium::R13, octavarium::R2010 },
+    { eRD2,  "plimmax",                    octavarium::R13, octavarium::R2010 },
+    { eBD,   "pelevation",                 octavarium::R13, octavarium::R2010 },
+    { eBD3,  "pucsorg",                    octavarium::R13, octavarium::R2010 },
+    { eBD3,  "pucsxdir",                   octavarium::R13, octavarium::R2010 },
+    { eBD3,  "pucsydir",                   octavarium::R13, octavarium::R2010 },
+    { eH,    "pucsname",                   octavarium::R13, octavarium::R2010 },
+    { eH,    "pucsbase",                   octavarium::R2000, octavarium::R2010 },
+    { eBS,   "pucsorthoview",              octavarium::R2000, octavarium::R2010 },
+    { eH,    "pucsorthoref",               octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pucsorgtop",                 octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pucsorgbottom",              octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pucsorgleft",                octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pucsorgright",               octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pucsorgfront",               octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "pucsorgback",                octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "insbase",                    octavarium::R13, octavarium::R2010 },
+    { eBD3,  "extmin",                     octavarium::R13, octavarium::R2010 },
+    { eBD3,  "extmax",                     octavarium::R13, octavarium::R2010 },
+    { eRD2,  "limmin",                     octavarium::R13, octavarium::R2010 },
+    { eRD2,  "limmax",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "elevation",                  octavarium::R13, octavarium::R2010 },
+    { eBD3,  "ucsorg",                     octavarium::R13, octavarium::R2010 },
+    { eBD3,  "ucsxdir",                    octavarium::R13, octavarium::R2010 },
+    { eBD3,  "ucsydir",                    octavarium::R13, octavarium::R2010 },
+    { eH,    "ucsname",                    octavarium::R13, octavarium::R2010 },
+    { eH,    "ucsbase",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "ucsorthoview",               octavarium::R2000, octavarium::R2010 },
+    { eH,    "ucsorthoref",                octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "ucsorgtop",                  octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "ucsorgbottom",               octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "ucsorgleft",                 octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "ucsorgright",                octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "ucsorgfront",                octavarium::R2000, octavarium::R2010 },
+    { eBD3,  "ucsorgback",                 octavarium::R2000, octavarium::R2010 },
+    { eTV,   "dimpost",                    octavarium::R2000, octavarium::R2010 },
+    { eTV,   "dimapost",                   octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimtol",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimlim",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimtih",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimtoh",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimse1",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimse2",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimalt",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimtofl",                    octavarium::R13, octavarium::R14 },
+    { eB,    "dimsah",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimtix",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimsoxd",                    octavarium::R13, octavarium::R14 },
+    { eRC,   "dimaltd",                    octavarium::R13, octavarium::R14 },
+    { eRC,   "dimzin",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimsd1",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimsd2",                     octavarium::R13, octavarium::R14 },
+    { eRC,   "dimtolj",                    octavarium::R13, octavarium::R14 },
+    { eRC,   "dimjust",                    octavarium::R13, octavarium::R14 },
+    { eRC,   "dimfit",                     octavarium::R13, octavarium::R14 },
+    { eB,    "dimupt",                     octavarium::R13, octavarium::R14 },
+    { eRC,   "dimtzin",                    octavarium::R13, octavarium::R14 },
+    { eRC,   "dimaltz",                    octavarium::R13, octavarium::R14 },
+    { eRC,   "dimalttz",                   octavarium::R13, octavarium::R14 },
+    { eRC,   "dimtad",                     octavarium::R13, octavarium::R14 },
+    { eBS,   "dimunit",                    octavarium::R13, octavarium::R14 },
+    { eBS,   "dimaunit",                   octavarium::R13, octavarium::R14 },
+    { eBS,   "dimdec",                     octavarium::R13, octavarium::R14 },
+    { eBS,   "dimtdec",                    octavarium::R13, octavarium::R14 },
+    { eBS,   "dimaltu",                    octavarium::R13, octavarium::R14 },
+    { eBS,   "dimalttd",                   octavarium::R13, octavarium::R14 },
+    { eH,    "dimtxsty",                   octavarium::R13, octavarium::R14 },
+    { eBD,   "dimscale",                   octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimasz",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimexo",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimdli",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimexe",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimrnd",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimdle",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimtp",                      octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimtm",                      octavarium::R13, octavarium::R2010 },
+    { eB,    "dimtol",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimlim",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimtih",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimtoh",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimse1",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimse2",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimtad",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimzin",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimazin",                    octavarium::R2000, octavarium::R2010 },
+    { eBD,   "dimtxt",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimcen",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimtsz",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimaltf",                    octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimlfac",                    octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimtvp",                     octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimtfac",                    octavarium::R13, octavarium::R2010 },
+    { eBD,   "dimgap",                     octavarium::R13, octavarium::R2010 },
+    { eT,    "dimpost",                    octavarium::R13, octavarium::R14 },
+    { eT,    "dimapost",                   octavarium::R13, octavarium::R14 },
+    { eT,    "dimblk",                     octavarium::R13, octavarium::R14 },
+    { eT,    "dimblk1",                    octavarium::R13, octavarium::R14 },
+    { eT,    "dimblk2",                    octavarium::R13, octavarium::R14 },
+    { eBD,   "dimaltrnd",                  octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimalt",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimaltd",                    octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimtofl",                    octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimsah",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimtix",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimsoxd",                    octavarium::R2000, octavarium::R2010 },
+    { eCMC,  "dimclrd",                    octavarium::R13, octavarium::R2010 },
+    { eCMC,  "dimclre",                    octavarium::R13, octavarium::R2010 },
+    { eCMC,  "dimclrt",                    octavarium::R13, octavarium::R2010 },
+    { eBS,   "dimadec",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimdec",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimtdec",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimaltu",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimalttd",                   octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimaunit",                   octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimfrac",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimlunit",                   octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimdsep",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimtmove",                   octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimjust",                    octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimsd1",                     octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimsd2",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimtolj",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimtzin",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimaltz",                    octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimalttz",                   octavarium::R2000, octavarium::R2010 },
+    { eB,    "dimupt",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimatfit",                   octavarium::R2000, octavarium::R2010 },
+    { eH,    "dimtxsty",                   octavarium::R2000, octavarium::R2010 },
+    { eH,    "dimldrblk",                  octavarium::R2000, octavarium::R2010 },
+    { eH,    "dimblkId",                   octavarium::R2000, octavarium::R2010 },
+    { eH,    "dimblk1Id",                  octavarium::R2000, octavarium::R2010 },
+    { eH,    "dimblk2Id",                  octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimlwd",                     octavarium::R2000, octavarium::R2010 },
+    { eBS,   "dimlwe",                     octavarium::R2000, octavarium::R2010 },
+    { eH,    "blockCtrlId",                octavarium::R13, octavarium::R2010 },
+    { eH,    "layerCtrlId",                octavarium::R13, octavarium::R2010 },
+    { eH,    "styleCtrlId",                octavarium::R13, octavarium::R2010 },
+    { eH,    "linetypeCtrlId",             octavarium::R13, octavarium::R2010 },
+    { eH,    "viewCtrlId",                 octavarium::R13, octavarium::R2010 },
+    { eH,    "ucsCtrlId",                  octavarium::R13, octavarium::R2010 },
+    { eH,    "vportCtrlId",                octavarium::R13, octavarium::R2010 },
+    { eH,    "appidCtrlId",                octavarium::R13, octavarium::R2010 },
+    { eH,    "dimstyleCtrlId",             octavarium::R13, octavarium::R2010 },
+    { eH,    "viewport",                   octavarium::R13, octavarium::R2000 },
+    { eH,    "dictionaryGroupId",          octavarium::R13, octavarium::R2010 },
+    { eH,    "dictionaryMLineStyleId",     octavarium::R13, octavarium::R2010 },
+    { eH,    "dictionaryNamedObjsId",      octavarium::R13, octavarium::R2010 },
+    { eBS,   "tstackalign",                octavarium::R2000, octavarium::R2010 },
+    { eBS,   "tstacksize",                 octavarium::R2000, octavarium::R2010 },
+    { eTV,   "hyperlinkbase",              octavarium::R2000, octavarium::R2010 },
+    { eTV,   "stylesheet",                 octavarium::R2000, octavarium::R2010 },
+    { eH,    "dictionaryLayoutsId",        octavarium::R2000, octavarium::R2010 },
+    { eH,    "dictionaryPlotSettingsId",   octavarium::R2000, octavarium::R2010 },
+    { eH,    "dictionaryPlotStylesId",     octavarium::R2000, octavarium::R2010 },
+    { eBL,   "flags",                      octavarium::R2000, octavarium::R2010 },
+    { eBS,   "insunits",                   octavarium::R2000, octavarium::R2010 },
+    { eBS,   "cepsntype",                  octavarium::R2000, octavarium::R2010 },
+    { eTV,   "fingerprintguid",            octavarium::R2000, octavarium::R2010 },
+    { eTV,   "versionguid",                octavarium::R2000, octavarium::R2010 },
+    { eH,    "block_recordPsId",           octavarium::R13, octavarium::R2010 },
+    { eH,    "block_recordMsId",           octavarium::R13, octavarium::R2010 },
+    { eH,    "ltypeByLayerId",             octavarium::R13, octavarium::R2010 },
+    { eH,    "ltypeByBlockId",             octavarium::R13, octavarium::R2010 },
+    { eH,    "ltypeContinuousId",          octavarium::R13, octavarium::R2010 },
+    { eBS,   "unknown54",                  octavarium::R14, octavarium::R2010 },
+    { eBS,   "unknown55",                  octavarium::R14, octavarium::R2010 },
+    { eBS,   "unknown56",                  octavarium::R14, octavarium::R2010 },
+    { eBS,   "unknown57",                  octavarium::R14, octavarium::R2010 },
+};
+
+// Object types of the common entities, as numbered in _subClasses.
+const int16_t entityTypes[] = { 19, 17, 18, 1, 27, 7, };
+
+inline std::wstring Text(int length, int seed)
+{
+    std::wstring text;
+
+    for(int i = 0; i < length; ++i)
+    {
+        text.push_back((wchar_t)(L'a' + (seed + i) % 26));
+    }
+
+    return text;
+}
+
+inline void Sentinel(BitWriter & w, const octavarium::byte_t * sentinel)
+{
+    for(int i = 0; i < 16; ++i)
+    {
+        w.RC(sentinel[i]);
+    }
+}
+
+inline void PatchRL(BitWriter & w, size_t offset, int32_t rl)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        w.PatchByte(offset + i, (uint8_t)((uint32_t) rl >> (i * 8)));
+    }
+}
+
+// Section crcs are seeded with 0xc0c1 and stored little endian.
+inline void SectionCRC(BitWriter & w, size_t crcStart)
+{
+    w.AlignByte();
+    w.RS((int16_t) octavarium::crc8Span(0xc0c1, &w.Bytes()[crcStart],
+                                        w.ByteSize() - crcStart));
+}
+
+inline void Append(std::vector<octavarium::byte_t> & file, const BitWriter & w)
+{
+    file.insert(file.end(), w.Bytes().begin(), w.Bytes().end());
+}
+
+inline BitWriter PreviewImage(const SyntheticDwgOptions & options, int32_t filePos)
+{
+    const int32_t headerSize = 80;
+    const int nImages = options.previewSize > 0 ? 2 : 1;
+    BitWriter w;
+    Sentinel(w, octavarium::sentinelImageDataStart);
+    w.RL(1 + nImages * 9 + headerSize + options.previewSize);
+    w.RC((uint8_t) nImages);
+
+    int32_t dataPos = filePos + 16 + 4 + 1 + nImages * 9;
+    w.RC(1);
+    w.RL(dataPos);
+    w.RL(headerSize);
+
+    if(options.previewSize > 0)
+    {
+        w.RC(2);
+        w.RL(dataPos + headerSize);
+        w.RL(options.previewSize);
+    }
+
+    for(int i = 0; i < headerSize; ++i)
+    {
+        w.RC(0);
+    }
+
+    for(int i = 0; i < options.previewSize; ++i)
+    {
+        w.RC((uint8_t) i);
+    }
+
+    Sentinel(w, octavarium::sentinelImageDataEnd);
+    return w;
+}
+
+inline BitWriter HeaderVars(const SyntheticDwgOptions & options)
+{
+    BitWriter w;
+    Sentinel(w, octavarium::sentinelHeaderVarsStart);
+    size_t crcStart = w.ByteSize();
+    w.RL(0);
+
+    int nVar = 0;
+
+    for(const HeaderVar & var : headerVars)
+    {
+        if(options.version < var.first || options.version > var.last)
+        {
+            continue;
+        }
+
+        switch(var.code)
+        {
+        case eB:
+            w.B(false);
+            break;
+
+        case eBS:
+            w.BS(0);
+            break;
+
+        case eBL:
+            w.BL(0);
+            break;
+
+        case eBD:
+            w.BD(1.0);
+            break;
+
+        case eBD3:
+            w.BD(0.0);
+            w.BD(0.0);
+            w.BD(1.0);
+            break;
+
+        case eRC:
+            w.RC(0);
+            break;
+
+        case eRD2:
+            w.RD(0.0);
+            w.RD(0.0);
+            break;
+
+        case eT:
+        case eTV:
+            w.T(Text(options.stringLength, nVar));
+            break;
+
+        case eCMC:
+            w.BS(256);
+            break;
+
+        case eH:
+            w.Handle(3, (uint64_t)(nVar + 1));
+            break;
+        }
+
+        ++nVar;
+    }
+
+    w.AlignByte();
+    PatchRL(w, crcStart, (int32_t)(w.ByteSize() - crcStart - 4));
+    SectionCRC(w, crcStart);
+    Sentinel(w, octavarium::sentinelHeaderVarsEnd);
+    return w;
+}
+
+inline BitWriter Classes(const SyntheticDwgOptions & options)
+{
+    BitWriter w;
+    Sentinel(w, octavarium::sentinelClassesSectionStart);
+    size_t crcStart = w.ByteSize();
+    w.RL(0);
+
+    for(int i = 0; i < options.numClasses; ++i)
+    {
+        std::wstring number = std::to_wstring(i);
+        w.BS((int16_t)(500 + i));
+        w.BS(0);
+        w.T(Text(options.stringLength, i));
+        w.T(L"AcDbSynthetic" + number);
+        w.T(L"SYNTHETIC" + number);
+        w.B(false);
+        w.BS(i % 2 ? 0x1f3 : 0x1f2);
+    }
+
+    w.AlignByte();
+    PatchRL(w, crcStart, (int32_t)(w.ByteSize() - crcStart - 4));
+    SectionCRC(w, crcStart);
+    Sentinel(w, octavarium::sentinelClassesSectionEnd);
+    return w;
+}
+
+// Each object is its size, type and filler, followed by a crc.
+inline BitWriter Object(const SyntheticDwgOptions & options, int nObject)
+{
+    int16_t type = entityTypes[nObject % (sizeof(entityTypes) / sizeof(entityTypes[0]))];
+
+    if(options.numClasses > 0 && nObject % 8 == 7)
+    {
+        type = (int16_t)(500 + (nObject / 8) % options.numClasses);
+    }
+
+    BitWriter body;
+    body.BS(type);
+
+    while(body.ByteSize() < (size_t) options.objectSize)
+    {
+        body.RC((uint8_t)(nObject + body.ByteSize()));
+    }
+
+    BitWriter w;
+    w.MS((uint32_t) body.ByteSize());
+
+    for(uint8_t b : body.Bytes())
+    {
+        w.RC(b);
+    }
+
+    SectionCRC(w, 0);
+    return w;
+}
+
+// Handle and file offset pairs, as deltas from the previous pair, in
+// sections of at most 2032 bytes. Section sizes and crcs are big endian.
+inline BitWriter ObjectMap(const std::vector<int32_t> & offsets)
+{
+    BitWriter w;
+    size_t nObject = 0;
+
+    for(;;)
+    {
+        size_t sectionStart = w.ByteSize();
+        w.RS(0);
+        int32_t lastHandle = 0, lastOffset = 0;
+
+        while(nObject < offsets.size() && w.ByteSize() - sectionStart < 2032 - 10)
+        {
+            int32_t handle = (int32_t) nObject + 1;
+            w.MC(handle - lastHandle);
+            w.MC(offsets[nObject] - lastOffset);
+            lastHandle = handle;
+            lastOffset = offsets[nObject];
+            ++nObject;
+        }
+
+        // the size counts the crc, but not itself
+        size_t sectionSize = w.ByteSize() - sectionStart;
+        w.PatchByte(sectionStart, (uint8_t)(sectionSize >> 8));
+        w.PatchByte(sectionStart + 1, (uint8_t) sectionSize);
+        uint16_t crc = octavarium::crc8Span(0xc0c1, &w.Bytes()[sectionStart],
+                                            w.ByteSize() - sectionStart);
+        w.RC((uint8_t)(crc >> 8));
+        w.RC((uint8_t) crc);
+
+        // the last section is empty
+        if(sectionSize == 2)
+        {
+            break;
+        }
+    }
+
+    return w;
+}
+
+struct SectionLocator
+{
+    int32_t seeker;
+    int32_t size;
+};
+
+// The R13 and R14 copy of the section locators, right after the object map.
+inline BitWriter SecondFileHeader(const SyntheticDwgOptions & options, int32_t filePos,
+                                  const SectionLocator * sections, int nSections)
+{
+    BitWriter w;
+    Sentinel(w, octavarium::sentinelSecondFileHeaderBegin);
+    size_t crcStart = w.ByteSize();
+    w.RL(0);
+    w.BL(filePos);
+
+    const std::string & sVersion = octavarium::OcBsDwgVersion::GetVersionId(options.version);
+
+    for(size_t i = 0; i < 6; ++i)
+    {
+        w.RC((uint8_t) sVersion[i]);
+    }
+
+    for(int i = 0; i < 8; ++i)
+    {
+        w.RC(0);
+    }
+
+    for(int i = 0; i < 4; ++i)
+    {
+        w.B(false);
+    }
+
+    w.RC(0x18);
+    w.RC(0x78);
+    w.RC(0x01);
+    w.RC(options.version == octavarium::R13 ? 0x04 : 0x05);
+
+    for(int i = 0; i < nSections; ++i)
+    {
+        w.RC((uint8_t) i);
+        w.BL(sections[i].seeker);
+        w.BL(sections[i].size);
+    }
+
+    // handseed first, then the control objects
+    w.BS(14);
+
+    for(int i = 0; i < 14; ++i)
+    {
+        int32_t handle = i == 0 ? options.numObjects + 1 : i;
+        w.RC(handle > 0xff ? (handle > 0xffff ? 3 : 2) : 1);
+        w.RC((uint8_t) i);
+
+        for(int shift = handle > 0xffff ? 16 : (handle > 0xff ? 8 : 0); shift >= 0; shift -= 8)
+        {
+            w.RC((uint8_t)(handle >> shift));
+        }
+    }
+
+    w.AlignByte();
+    PatchRL(w, crcStart, (int32_t)(w.ByteSize() + 2 - crcStart - 4));
+    SectionCRC(w, crcStart);
+
+    if(options.version == octavarium::R14)
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            w.RC(0);
+        }
+    }
+
+    Sentinel(w, octavarium::sentinelSecondFileHeaderEnd);
+    return w;
+}
+
+// AcDb:Template, the template description and the measurement system.
+inline BitWriter DataSection(const SyntheticDwgOptions & options)
+{
+    std::wstring description = Text(options.stringLength, 0);
+    BitWriter w;
+    w.BS((int16_t) description.size());
+
+    for(size_t i = 0; i < description.size(); ++i)
+    {
+        w.RC((uint8_t) description[i]);
+    }
+
+    w.BS(0);
+    w.AlignByte();
+    return w;
+}
+} // namespace synthetic_dwg
+
+/**
+ *  Makes an R13 to R2000 drawing that OcDbDatabase::ReadDwg accepts, with
+ *  valid sentinels and crcs, to time reading drawings of any size. The
+ *  objects carry a type and filler bytes only.
+ */
+inline std::vector<octavarium::byte_t> MakeSyntheticDwg(const SyntheticDwgOptions & options)
+{
+    using namespace synthetic_dwg;
+    const int nSections = 5;
+    std::vector<octavarium::byte_t> file;
+
+    // file header, the image seeker, locators and crc are filled in last
+    BitWriter hdr;
+    const std::string & sVersion = octavarium::OcBsDwgVersion::GetVersionId(options.version);
+
+    for(size_t i = 0; i < 6; ++i)
+    {
+        hdr.RC((uint8_t) sVersion[i]);
+    }
+
+    hdr.RL(0);
+    hdr.RC(0);
+    hdr.RC(0);
+    hdr.RC(1);
+    size_t imageSeekerPos = hdr.ByteSize();
+    hdr.RL(0);
+    hdr.RS(0);
+    hdr.RS(30);                        // ANSI_1252
+    hdr.RL(nSections);
+    size_t locatorsPos = hdr.ByteSize();
+
+    for(int i = 0; i < nSections * 9; ++i)
+    {
+        hdr.RC(0);
+    }
+
+    size_t crcPos = hdr.ByteSize();
+    hdr.RS(0);
+    Sentinel(hdr, octavarium::sentinelR13_R2000);
+    Append(file, hdr);
+
+    int32_t imageSeeker = (int32_t) file.size();
+    Append(file, PreviewImage(options, imageSeeker));
+
+    SectionLocator sections[nSections];
+    sections[0].seeker = (int32_t) file.size();
+    Append(file, HeaderVars(options));
+    sections[0].size = (int32_t) file.size() - sections[0].seeker;
+
+    sections[1].seeker = (int32_t) file.size();
+    Append(file, Classes(options));
+    sections[1].size = (int32_t) file.size() - sections[1].seeker;
+
+    std::vector<int32_t> offsets;
+    offsets.reserve(options.numObjects);
+
+    for(int i = 0; i < options.numObjects; ++i)
+    {
+        offsets.push_back((int32_t) file.size());
+        Append(file, Object(options, i));
+    }
+
+    sections[2].seeker = (int32_t) file.size();
+    Append(file, ObjectMap(offsets));
+    sections[2].size = (int32_t) file.size() - sections[2].seeker;
+
+    // The second file header lists the sections that follow it, so its
+    // size is needed first. It only changes when a locator value crosses
+    // a bit code size boundary, two passes settle it.
+    BitWriter dataSection = DataSection(options);
+    int32_t secondHdrPos = (int32_t) file.size();
+    size_t secondHdrSize = 0;
+    BitWriter secondHdr;
+
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        sections[3].seeker = secondHdrPos + (int32_t) secondHdrSize;
+        sections[3].size = 4;
+        sections[4].seeker = sections[3].seeker + sections[3].size;
+        sections[4].size = (int32_t) dataSection.ByteSize();
+
+        if(options.version == octavarium::R13 || options.version == octavarium::R14)
+        {
+            secondHdr = SecondFileHeader(options, secondHdrPos, sections, nSections);
+        }
+
+        secondHdrSize = secondHdr.ByteSize();
+    }
+
+    Append(file, secondHdr);
+    file.insert(file.end(), 4, 0);
+    Append(file, dataSection);
+
+    // back to the file header
+    for(int i = 0; i < 4; ++i)
+    {
+        file[imageSeekerPos + i] = (octavarium::byte_t)((uint32_t) imageSeeker >> (i * 8));
+    }
+
+    for(int i = 0; i < nSections; ++i)
+    {
+        octavarium::byte_t * locator = &file[locatorsPos + i * 9];
+        locator[0] = (octavarium::byte_t) i;
+
+        for(int j = 0; j < 4; ++j)
+        {
+            locator[1 + j] = (octavarium::byte_t)((uint32_t) sections[i].seeker >> (j * 8));
+            locator[5 + j] = (octavarium::byte_t)((uint32_t) sections[i].size >> (j * 8));
+        }
+    }
+
+    // the header crc is seeded with 0 and xor'ed with a constant that
+    // depends on the number of locators, 0x3cc4 for 5.
+    uint16_t crc = octavarium::crc8Span(0, &file[0], crcPos) ^ 0x3cc4;
+    file[crcPos] = (octavarium::byte_t) crc;
+    file[crcPos + 1] = (octavarium::byte_t)(crc >> 8);
+    return file;
+}
@@ -0,0 +1,20 @@
+/**
+ *	@file
+ *  @brief Definitions the Visual Studio build gets from its headers
+ *
+ *  Force included ahead of every DrawGin source in the benchmark build.
+ */
+
+#pragma once
+
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#   define __declspec(x)
+#   define _MAX_PATH 260
+#   define __FUNC__NAME__ __FUNCTION__
+#endif
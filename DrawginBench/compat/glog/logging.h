@@ -0,0 +1,88 @@
+/**
+ *	@file
+ *  @brief Stands in for GLog in the benchmark build
+ *
+ *  Logging is compiled out. Only what DrawGin library refers to is
+ *  declared.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <ostream>
+#include <string>
+
+namespace google
+{
+typedef uint32_t uint32;
+enum LogSeverity { INFO = 0, WARNING = 1, ERROR = 2, FATAL = 3 };
+
+namespace base
+{
+class Logger
+{
+public:
+    virtual ~Logger() {}
+    virtual void Write(bool should_flush, time_t timestamp, const char * message,
+                       int length) = 0;
+    virtual void Flush() = 0;
+    virtual uint32 LogSize() = 0;
+};
+
+inline Logger * GetLogger(int) { return nullptr; }
+inline void SetLogger(int, Logger *) {}
+}
+
+inline void InitGoogleLogging(const char *) {}
+inline void ShutdownGoogleLogging() {}
+inline void FlushLogFiles(int) {}
+inline void SetLogFilenameExtension(const char *) {}
+
+// Swallows everything streamed into it.
+struct NullStream
+{
+    template<typename T>
+    NullStream & operator<<(const T &) { return *this; }
+    NullStream & operator<<(std::ostream & (*)(std::ostream &)) { return *this; }
+};
+
+// Aborts when the checked condition is false, as GLog's CHECK does.
+struct CheckStream : NullStream
+{
+    CheckStream(bool ok, const char * condition, const char * file, int line)
+        : m_ok(ok), m_condition(condition), m_file(file), m_line(line) {}
+    ~CheckStream()
+    {
+        if(!m_ok)
+        {
+            fprintf(stderr, "%s:%d: Check failed: %s\n", m_file, m_line, m_condition);
+            abort();
+        }
+    }
+
+    bool m_ok;
+    const char * m_condition;
+    const char * m_file;
+    int m_line;
+};
+}
+
+inline std::string FLAGS_log_dir, FLAGS_log_link;
+inline int FLAGS_v, FLAGS_logbuflevel, FLAGS_logbufsecs, FLAGS_max_log_size,
+           FLAGS_minloglevel, FLAGS_stderrthreshold;
+inline bool FLAGS_alsologtostderr, FLAGS_logtostderr, FLAGS_log_prefix,
+            FLAGS_stop_logging_if_full_disk;
+
+#define LOG(severity) google::NullStream()
+#define VLOG(level) google::NullStream()
+#define LOG_IF(severity, condition) google::NullStream()
+#define CHECK(condition) google::CheckStream(!!(condition), #condition, __FILE__, __LINE__)
+#ifdef NDEBUG
+#   define DCHECK(condition) while(false) CHECK(condition)
+#else
+#   define DCHECK(condition) CHECK(condition)
+#endif
+#define VLOG_IS_ON(level) false
@@ -0,0 +1,11 @@
+/**
+ *	@file
+ *  @brief Stands in for the Windows tchar.h in the benchmark build
+ */
+
+#pragma once
+
+#include <wchar.h>
+
+typedef wchar_t TCHAR;
+#define _T(x) L##x
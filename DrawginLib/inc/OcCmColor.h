@@ -47,7 +47,9 @@
 #pragma once
 
 // Note: OcColor is a stub class and not fully implemented. It is provided to
-// support reading the drawing header section in OcBsDatabaseHeaderVars.
+// support reading the drawing header section in OcBsDatabaseHeaderVars,
+// and only keeps the color index and rgb value, not the color and book
+// names.
 
 BEGIN_OCTAVARIUM_NS
 
@@ -56,9 +58,17 @@ class DRAWGIN_API OcCmColor
     //DISABLE_COPY(OcCmColor);
 public:
     OcCmColor(void);
+    OcCmColor(int16_t colorIndex, int32_t rgb);
     virtual ~OcCmColor(void);
 
+    int16_t ColorIndex(void) const;
+    int32_t Rgb(void) const;        // R2004 and later, 0 otherwise
+
     friend std::ostream& operator<<(std::ostream& out, const OcCmColor& color);
+
+private:
+    int16_t m_colorIndex;
+    int32_t m_rgb;
 };
 
 END_OCTAVARIUM_NS
@@ -122,7 +122,9 @@
 #endif
 
 
-#ifndef NDEBUG
+// Function entry logging is very verbose and dominates the run time of
+// debug builds, so it has to be asked for with OC_TRACE_FUNCTIONS.
+#if !defined(NDEBUG) && defined(OC_TRACE_FUNCTIONS)
 #    define VLOG_FUNC_NAME VLOG(5) << __FUNC__NAME__
 #else
 #    define VLOG_FUNC_NAME
@@ -0,0 +1,118 @@
+/**
+ *	@file
+ *  @brief Defines OcDbBatchLoader class
+ *
+ *  Reads many drawings in parallel on one set of worker threads
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include <functional>
+#include "OcError.h"
+#include "OcDbDatabase.h"
+
+BEGIN_OCTAVARIUM_NS
+
+class OcDbBatchLoaderPrivate;
+EXPIMP_TEMPLATE template class DRAWGIN_API std::unique_ptr<OcDbBatchLoaderPrivate>;
+
+/**
+ *  Reads a list of drawings, files or buffers, several at a time. Each
+ *  worker thread takes the next drawing in the list, reads it into a new
+ *  OcDbDatabase and hands it to the callback. The objects of a drawing
+ *  are decoded on the threads left idle by the other drawings, so the
+ *  last few drawings of a batch still use every thread.
+ *
+ *  The memory budget limits how many drawings are read at once. A
+ *  drawing only starts when the sizes of the drawings in flight plus its
+ *  own fit the budget, a drawing larger than the whole budget is read on
+ *  its own. A drawing is in flight until the callback returns.
+ */
+class DRAWGIN_API OcDbBatchLoader
+{
+    DISABLE_COPY(OcDbBatchLoader);
+    std::unique_ptr<OcDbBatchLoaderPrivate> m_pImpl;
+
+public:
+    /**
+     *  Called once per drawing with its position in the list and the
+     *  result of reading it. pDb holds the database, including after a
+     *  failed read; move it out to keep it, otherwise it is destroyed
+     *  when the callback returns. Called from the worker threads, for
+     *  several drawings at the same time.
+     */
+    typedef std::function<void (size_t index, OcApp::ErrorStatus es,
+                                std::unique_ptr<OcDbDatabase> & pDb)> Callback;
+
+    /**
+     *  nThreads of 0 uses one per hardware thread. memoryBudget is in
+     *  bytes, 0 doesn't limit the number of drawings in flight other than
+     *  by nThreads.
+     */
+    OcDbBatchLoader(int nThreads = 0, uint64_t memoryBudget = 0);
+    virtual ~OcDbBatchLoader(void);
+
+    /**
+     *  Adds a drawing to the list, returns its index.
+     */
+    size_t Add(const std::string & sFilename,
+               OcDbDatabase::ReadMode mode = OcDbDatabase::eReadAll);
+
+    /**
+     *  Adds a drawing held in memory. The data must stay valid until Run
+     *  returns, or for the lifetime of the database with eReadLazy.
+     */
+    size_t Add(const uint8_t * data, size_t len,
+               OcDbDatabase::ReadMode mode = OcDbDatabase::eReadAll);
+
+    size_t Size(void) const;
+
+    /**
+     *  Reads every drawing added since the last call and returns when all
+     *  of the callbacks have returned. Exceptions thrown while reading or
+     *  by the callback stop the batch and are rethrown here once the
+     *  drawings already in flight are done.
+     */
+    void Run(const Callback & callback);
+};
+
+END_OCTAVARIUM_NS
@@ -47,10 +47,13 @@
 
 #include "OcError.h"
 #include "OcRxObject.h"
+#include "OcDbReadStats.h"
+#include "OcDbProbeInfo.h"
 
 BEGIN_OCTAVARIUM_NS
 
 class OcDbDatabasePrivate;
+class OcDbObjectId;
 EXPIMP_TEMPLATE template class DRAWGIN_API std::unique_ptr<OcDbDatabasePrivate>;
 
 
@@ -63,7 +66,80 @@ public:
     OcDbDatabase(bool buildDefaultDrawing = true, bool noDocument = false);
     virtual ~OcDbDatabase(void);
 
-    OcApp::ErrorStatus ReadDwg(const std::string & sFilename);
+    /**
+     *  eReadAll decodes every object while reading the drawing.<br>
+     *  eReadLazy reads the file header, header variables, classes and
+     *  object map, objects are decoded the first time they are accessed.
+     *  The drawing stays open until another drawing is read or the
+     *  database is destroyed.
+     */
+    enum ReadMode { eReadAll = 0, eReadLazy, };
+
+    /**
+     *  How ReadDwg(sFilename) reads the file.<br>
+     *  eMapFile, the default, decodes from a memory mapped view of the
+     *  file, and falls back to eFileStream when it can't be mapped.<br>
+     *  eFileStream reads through a buffered std::fstream.
+     */
+    enum FileAccess { eMapFile = 0, eFileStream, };
+
+    OcApp::ErrorStatus ReadDwg(const std::string & sFilename,
+                               ReadMode mode = eReadAll);
+
+    /**
+     *  Reads a drawing held in memory, for example one received over the
+     *  network, without writing it to disk first. The data is decoded in
+     *  place and is not copied, it only needs to stay valid for the
+     *  duration of the call, or for the lifetime of the database with
+     *  eReadLazy.
+     */
+    OcApp::ErrorStatus ReadDwg(const uint8_t * data, size_t len,
+                               ReadMode mode = eReadAll);
+
+    /**
+     *  Reads the file header and, with bHeaderVars, the header variables
+     *  of a drawing into info, skipping the preview image and everything
+     *  after the header variables. Only the first few kilobytes of the
+     *  file are read.
+     */
+    static OcApp::ErrorStatus Probe(const std::string & sFilename, OcDbProbeInfo & info,
+                                    bool bHeaderVars = true);
+    static OcApp::ErrorStatus Probe(const uint8_t * data, size_t len, OcDbProbeInfo & info,
+                                    bool bHeaderVars = true);
+
+    /**
+     *  Returns the type of the object objId refers to, decoding the object
+     *  first if it has not been yet. Safe to call from several threads at
+     *  once, also on a database read with eReadLazy, where the decodes
+     *  take turns on the drawing's stream.
+     */
+    OcApp::ErrorStatus ObjectType(const OcDbObjectId & objId, uint16_t & type);
+
+    /**
+     *  Writes the fields most recently decoded on the calling thread, with
+     *  their bit offsets and values. Only builds with OC_TRACE_BITSTREAM,
+     *  debug builds by default, record fields.
+     */
+    static void DumpTrace(std::ostream & out);
+
+    /**
+     *  Timings and stream activity of the last ReadDwg call, broken down
+     *  by drawing file section and by object type. The object type
+     *  breakdown is only filled by eReadAll, eReadLazy leaves it empty.
+     */
+    const OcDbReadStats & ReadStats() const;
+
+    /**
+     *  Number of threads ReadDwg decodes objects with when the drawing is
+     *  in memory or memory mapped. 0, the default, uses one per hardware
+     *  thread.
+     */
+    void SetDecodeThreads(int nThreads);
+
+    /**
+     *  Selects how following ReadDwg(sFilename) calls read the file.
+     */
+    void SetFileAccess(FileAccess access);
 
 protected:
     OcDbDatabase(std::unique_ptr<OcDbDatabasePrivate> & d);
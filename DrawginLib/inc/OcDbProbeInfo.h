@@ -0,0 +1,89 @@
+/**
+ *	@file
+ *  @brief Defines OcDbProbeInfo
+ *
+ *  What OcDbDatabase::Probe finds out about a drawing
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include "OcGePoint3D.h"
+
+BEGIN_OCTAVARIUM_NS
+
+struct OcDbSectionLocator
+{
+    OcDbSectionLocator() : recordNumber(0), seeker(0), size(0) {}
+    int8_t recordNumber;
+    int32_t seeker;     // file offset of the section
+    int32_t size;
+};
+
+EXPIMP_TEMPLATE template class DRAWGIN_API std::allocator<OcDbSectionLocator>;
+EXPIMP_TEMPLATE template class DRAWGIN_API std::vector<OcDbSectionLocator, std::allocator<OcDbSectionLocator> >;
+
+/**
+ *  The file header of a drawing and a few of its header variables, read
+ *  without decoding the rest of the file.
+ */
+struct DRAWGIN_API OcDbProbeInfo
+{
+    OcDbProbeInfo();
+
+    std::string version;            // file id, "AC1014" for R14
+    int8_t maintenanceVersion;
+    int16_t codePage;               // drawing code page index
+    std::vector<OcDbSectionLocator> sections;
+
+    // Only set when header variables were asked for and the drawing has
+    // them (R13c3 and later).
+    bool hasHeaderVars;
+    OcGePoint3D extmin;
+    OcGePoint3D extmax;
+    int16_t insunits;               // R2000 and later, 0 otherwise
+    int32_t tdupdateDay;            // julian day
+    int32_t tdupdateMs;             // milliseconds into the day
+
+    void Clear();
+};
+
+END_OCTAVARIUM_NS
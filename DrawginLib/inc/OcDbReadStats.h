@@ -0,0 +1,101 @@
+/**
+ *	@file
+ *  @brief Defines OcDbReadStats
+ *
+ *  Where the time and I/O went while reading a drawing
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+BEGIN_OCTAVARIUM_NS
+
+struct OcDbObjectTypeStats
+{
+    OcDbObjectTypeStats() : count(0), bytes(0) {}
+    uint32_t count;
+    uint64_t bytes;     // sum of the object sizes
+};
+
+EXPIMP_TEMPLATE template class DRAWGIN_API std::allocator<OcDbObjectTypeStats>;
+EXPIMP_TEMPLATE template class DRAWGIN_API std::vector<OcDbObjectTypeStats, std::allocator<OcDbObjectTypeStats> >;
+
+/**
+ *  Statistics for the last OcDbDatabase::ReadDwg call, one entry per
+ *  section of the drawing file that was read, plus a breakdown of the
+ *  decoded objects by type.
+ */
+struct DRAWGIN_API OcDbReadStats
+{
+    enum Phase
+    {
+        eFileHeader = 0,
+        ePreviewImage,
+        eHeaderVars,
+        eClasses,
+        eObjectMap,
+        eSecondFileHeader,
+        eDataSection,
+        eObjects,
+        eNumPhases
+    };
+
+    struct PhaseStats
+    {
+        PhaseStats() : seconds(0.0), bytes(0), seeks(0), refills(0), crcBytes(0) {}
+        double seconds;     // wall time
+        uint64_t bytes;     // bytes decoded
+        uint64_t seeks;
+        uint64_t refills;   // file reads, always 0 when decoding from memory
+        uint64_t crcBytes;  // bytes checked against a section CRC
+    };
+
+    PhaseStats phases[eNumPhases];
+
+    // Indexed by object type, types not in the drawing have a count of 0.
+    // Empty when objects were not decoded (OcDbDatabase::eReadLazy).
+    std::vector<OcDbObjectTypeStats> objectTypes;
+
+    static const char * PhaseName(Phase phase);
+    void Clear();
+};
+
+END_OCTAVARIUM_NS
@@ -0,0 +1,99 @@
+/**
+ *	@file
+ *  @brief Defines OcDbThumbnail class
+ *
+ *  Reads the preview image of a drawing and nothing else
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include "OcError.h"
+
+BEGIN_OCTAVARIUM_NS
+
+class OcDbThumbnailPrivate;
+EXPIMP_TEMPLATE template class DRAWGIN_API std::unique_ptr<OcDbThumbnailPrivate>;
+
+/**
+ *  The preview image stored in a drawing. Read decodes the file header,
+ *  seeks to the image section it points at and reads that section alone.
+ *  Files are memory mapped and the image data is not copied, the data
+ *  pointers refer to the mapping. They stay valid until the next Read or
+ *  until the OcDbThumbnail is destroyed.
+ */
+class DRAWGIN_API OcDbThumbnail
+{
+    DISABLE_COPY(OcDbThumbnail);
+    std::unique_ptr<OcDbThumbnailPrivate> m_pImpl;
+
+public:
+    OcDbThumbnail(void);
+    virtual ~OcDbThumbnail(void);
+
+    /**
+     *  Returns eNotFound for drawings older than R13c3, which don't have
+     *  a preview image.
+     */
+    OcApp::ErrorStatus Read(const std::string & sFilename);
+
+    /**
+     *  Reads the preview image of a drawing held in memory. The data
+     *  pointers refer to data, which has to outlive their use.
+     */
+    OcApp::ErrorStatus Read(const uint8_t * data, size_t len);
+
+    /**
+     *  The bitmap is a device independent bitmap, BITMAPINFOHEADER and
+     *  pixels, without the BITMAPFILEHEADER a .bmp file starts with.
+     *  Sizes are 0 for images the drawing doesn't have.
+     */
+    const uint8_t * BmpData(void) const;
+    size_t BmpSize(void) const;
+
+    const uint8_t * WmfData(void) const;
+    size_t WmfSize(void) const;
+
+    const uint8_t * HeaderData(void) const;
+    size_t HeaderSize(void) const;
+};
+
+END_OCTAVARIUM_NS
@@ -54,624 +54,1026 @@
 BEGIN_OCTAVARIUM_NS
 using namespace std;
 
-OcBsDatabaseHeaderVars::OcBsDatabaseHeaderVars(void)
+namespace
 {
-    VLOG_FUNC_NAME;
+// bitcode type each table type is decoded with
+template<OcBsDatabaseHeaderVars::Type> struct FieldCode;
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eB>   { typedef bitcode::B type;   };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eBS>  { typedef bitcode::BS type;  };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eBL>  { typedef bitcode::BL type;  };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eBD>  { typedef bitcode::BD type;  };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eRC>  { typedef bitcode::RC type;  };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eRD2> { typedef bitcode::RD2 type; };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eBD3> { typedef bitcode::BD3 type; };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eT>   { typedef bitcode::T type;   };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eTV>  { typedef bitcode::TV type;  };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eCMC> { typedef bitcode::CMC type; };
+template<> struct FieldCode<OcBsDatabaseHeaderVars::eH>   { typedef OcDbObjectId type; };
+
+// Decodes one value for drawing version V. TV and CMC change layout
+// between versions and use the stream's version specific readers, the
+// rest are the same in every version.
+template<DWG_VERSION V, typename BC>
+void Decode(OcBsStreamIn & in, BC & value)
+{
+    in >> value;
 }
 
+template<DWG_VERSION V>
+void Decode(OcBsStreamIn & in, bitcode::TV & value)
+{
+    in.ReadTV<V>(value);
+}
 
-OcBsDatabaseHeaderVars::~OcBsDatabaseHeaderVars(void)
+template<DWG_VERSION V>
+void Decode(OcBsStreamIn & in, bitcode::CMC & value)
 {
-    VLOG_FUNC_NAME;
+    in.ReadCMC<V>(value);
 }
 
-OcApp::ErrorStatus OcBsDatabaseHeaderVars::ReadDwg(OcBsStreamIn & in, OcDbDatabasePrivate *& m_pDb)
+// Converts a decoded bitcode to the type the database member holds. The
+// member isn't always the bitcode's size (dimsav is a bool stored as BS
+// in R13).
+template<typename V>
+struct FieldCast
 {
-    VLOG_FUNC_NAME;
-    VLOG(4) << "OcBsDatabaseHearderVars::ReadDwg entered";
+    template<typename BC>
+    static V From(const BC & value)
+    {
+        return (V) value.t;
+    }
+};
 
-    if(!m_pDb)
+template<>
+struct FieldCast<OcGePoint2D>
+{
+    static OcGePoint2D From(const bitcode::RD2 & value)
     {
-        return OcApp::eNullPointer;
+        return OcGePoint2D(value.t.x, value.t.y);
     }
+};
 
-    bitcode::RC sentinelData[16];
-    in.ReadRC(sentinelData, 16);
-    if(!CompareSentinels(sentinelHeaderVarsStart, sentinelData))
+template<>
+struct FieldCast<OcGePoint3D>
+{
+    static OcGePoint3D From(const bitcode::BD3 & value)
     {
-        return OcApp::eInvalidHeaderSentinal;
+        return OcGePoint3D(value.t.x, value.t.y, value.t.z);
     }
+};
 
-    const DWG_VERSION dwgVersion = in.Version();
+template<>
+struct FieldCast<OcDbObjectId>
+{
+    static const OcDbObjectId & From(const OcDbObjectId & value)
+    {
+        return value;
+    }
+};
 
-    // per spec, set initial CRC value to 0xc0c1
-    in.SetCalcedCRC(0xc0c1);
+template<>
+struct FieldCast<OcDbHardOwnershipId>
+{
+    static OcDbHardOwnershipId From(const OcDbObjectId & value)
+    {
+        OcDbHardOwnershipId id;
+        id.Handle(value.Handle());
+        return id;
+    }
+};
 
-    // spec says this is a R2007 variable only and is the size in "bits",
-    // but that doesn't seem totally correct.
-    // At least for the R2008 drawing down, converted to R14, this value
-    // appears to be the size of the header in "bytes".
-    //   if(dwgVersion == R2007) {
-    //       BS_STREAMIN(bitcode::RL, in, pHdr->size, "Header variables size");
-    int size;
-    BS_STREAMIN(bitcode::RL, in, size, "Header variables size");
-    //   }
+// OcCmColor keeps the index and rgb value, the names are dropped.
+template<>
+struct FieldCast<OcCmColor>
+{
+    static OcCmColor From(const bitcode::CMC & value)
+    {
+        return OcCmColor(value.t.index, value.t.rgb);
+    }
+};
 
-    auto startPos = in.FilePosition();
-    // common
-    BS_STREAMIN(bitcode::BD, in, m_pDb->unknown1(),  "unknown1");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->unknown2(),  "unknown2");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->unknown3(),  "unknown3");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->unknown4(),  "unknown4");
-    BS_STREAMIN(bitcode::TV, in, m_pDb->unknown5(),  "unknown5");
-    BS_STREAMIN(bitcode::TV, in, m_pDb->unknown6(),  "unknown6");
-    BS_STREAMIN(bitcode::TV, in, m_pDb->unknown7(),  "unknown7");
-    BS_STREAMIN(bitcode::TV, in, m_pDb->unknown8(),  "unknown8");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->unknown9(),  "unknown9");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->unknown10(), "unknown10");
+// Value recorded for the field, taken from the member once it's stored.
+// Colors record the decoded index as the member doesn't keep it.
+template<typename BC, typename V>
+uint64_t FieldTrace(const BC & /*value*/, const V & var)
+{
+    return TraceValue(var);
+}
+
+template<typename V>
+uint64_t FieldTrace(const bitcode::CMC & value, const V & /*var*/)
+{
+    return (uint64_t) value.t.index;
+}
 
-    if(dwgVersion == R13 || dwgVersion == R14)
+void SkipBD(OcBsStreamIn & in)
+{
+    if(in.ReadBits(2) == 0)
     {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->unknown11(), "unknown11");
+        in.SkipBits(64);
     }
+}
 
+void SkipText(OcBsStreamIn & in, int unitBits)
+{
+    bitcode::BS length;
+    in >> length;
+    in.SkipBits((uint64_t) std::max<int>(length.t, 0) * unitBits);
+}
+
+template<DWG_VERSION V>
+void SkipTV(OcBsStreamIn & in)
+{
+    SkipText(in, V < R2007 ? 8 : 16);
+}
+
+// A field's read function for drawing version V
+#define HEADER_VAR_READ(TYPE, VAR, V)                                       \
+      [](OcBsStreamIn & in, OcDbDatabasePrivate & db) -> uint64_t           \
+      {                                                                     \
+          typedef std::decay<decltype(db.VAR())>::type value_type;          \
+          FieldCode<OcBsDatabaseHeaderVars::e##TYPE>::type value;           \
+          Decode<V>(in, value);                                             \
+          db.VAR(FieldCast<value_type>::From(value));                       \
+          return FieldTrace(value, db.VAR());                               \
+      }
+#define HEADER_VAR_IF(TYPE, VAR, FIRST, LAST, PRESENT_IF)                   \
+    { #VAR, OcBsDatabaseHeaderVars::e##TYPE, FIRST, LAST, PRESENT_IF,       \
+      { nullptr,                                                            \
+        HEADER_VAR_READ(TYPE, VAR, R13),   HEADER_VAR_READ(TYPE, VAR, R14),   \
+        HEADER_VAR_READ(TYPE, VAR, R2000), HEADER_VAR_READ(TYPE, VAR, R2004), \
+        HEADER_VAR_READ(TYPE, VAR, R2007), HEADER_VAR_READ(TYPE, VAR, R2010) } }
+#define HEADER_VAR(TYPE, VAR, FIRST, LAST) HEADER_VAR_IF(TYPE, VAR, FIRST, LAST, -1)
+
+// The header variables section in file order. R2010 is the newest
+// version read, entries ending there are in every later version too.
+const OcBsDatabaseHeaderVars::Field headerVarFields[] =
+{
     // common
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->currentVpId(), "currentvpId");
-    BS_STREAMIN(bitcode::B, in, m_pDb->dimaso(),        "dimaso");
-    BS_STREAMIN(bitcode::B, in, m_pDb->dimsho(),        "dimsho");
+    HEADER_VAR(BD, unknown1,  R13, R2010),
+    HEADER_VAR(BD, unknown2,  R13, R2010),
+    HEADER_VAR(BD, unknown3,  R13, R2010),
+    HEADER_VAR(BD, unknown4,  R13, R2010),
+    HEADER_VAR(TV, unknown5,  R13, R2010),
+    HEADER_VAR(TV, unknown6,  R13, R2010),
+    HEADER_VAR(TV, unknown7,  R13, R2010),
+    HEADER_VAR(TV, unknown8,  R13, R2010),
+    HEADER_VAR(BL, unknown9,  R13, R2010),
+    HEADER_VAR(BL, unknown10, R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimsav(), "dimsav");
-    }
+    // R13-R14
+    HEADER_VAR(BS, unknown11, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::B, in, m_pDb->plinegen(),  "plinegen");
-    BS_STREAMIN(bitcode::B, in, m_pDb->orthomode(), "orthomode");
-    BS_STREAMIN(bitcode::B, in, m_pDb->regenmode(), "regenmode");
-    BS_STREAMIN(bitcode::B, in, m_pDb->fillmode(),  "fillmode");
-    BS_STREAMIN(bitcode::B, in, m_pDb->qtextmode(), "qtextmode");
-    BS_STREAMIN(bitcode::B, in, m_pDb->psltscale(), "psltscale");
-    BS_STREAMIN(bitcode::B, in, m_pDb->limcheck(),  "limcheck");
+    HEADER_VAR(H, currentVpId, R13, R2010),
+    HEADER_VAR(B, dimaso,      R13, R2010),
+    HEADER_VAR(B, dimsho,      R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->blipmode(), "blipmode");
-    }
+    // R13-R14
+    HEADER_VAR(B, dimsav, R13, R14),
 
-    if(dwgVersion >= R2004)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->undocumented(), "undocumented");
-    }
+    // common
+    HEADER_VAR(B, plinegen,  R13, R2010),
+    HEADER_VAR(B, orthomode, R13, R2010),
+    HEADER_VAR(B, regenmode, R13, R2010),
+    HEADER_VAR(B, fillmode,  R13, R2010),
+    HEADER_VAR(B, qtextmode, R13, R2010),
+    HEADER_VAR(B, psltscale, R13, R2010),
+    HEADER_VAR(B, limcheck,  R13, R2010),
+
+    // R13-R14
+    HEADER_VAR(B, blipmode, R13, R14),
+
+    // R2004+
+    HEADER_VAR(B, undocumented, R2004, R2010),
 
     // common
-    BS_STREAMIN(bitcode::B, in, m_pDb->usertimer(), "usertimer");
-    BS_STREAMIN(bitcode::B, in, m_pDb->skpoly(),    "skpoly");
-    BS_STREAMIN(bitcode::B, in, m_pDb->angdir(),    "angdir");
-    BS_STREAMIN(bitcode::B, in, m_pDb->splframe(),  "splframe");
+    HEADER_VAR(B, usertimer, R13, R2010),
+    HEADER_VAR(B, skpoly,    R13, R2010),
+    HEADER_VAR(B, angdir,    R13, R2010),
+    HEADER_VAR(B, splframe,  R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->attreq(), "attreq");
-        BS_STREAMIN(bitcode::B, in, m_pDb->attdia(), "attdia");
-    }
+    // R13-R14
+    HEADER_VAR(B, attreq, R13, R14),
+    HEADER_VAR(B, attdia, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::B, in, m_pDb->mirrtext(),  "mirrtext");
-    BS_STREAMIN(bitcode::B, in, m_pDb->worldview(), "worldview");
+    HEADER_VAR(B, mirrtext,  R13, R2010),
+    HEADER_VAR(B, worldview, R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->wireframe(), "wireframe");
-    }
+    // R13-R14
+    HEADER_VAR(B, wireframe, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::B, in, m_pDb->tilemode(),  "tilemode");
-    BS_STREAMIN(bitcode::B, in, m_pDb->plimcheck(), "plimcheck");
-    BS_STREAMIN(bitcode::B, in, m_pDb->visretain(), "visretain");
+    HEADER_VAR(B, tilemode,  R13, R2010),
+    HEADER_VAR(B, plimcheck, R13, R2010),
+    HEADER_VAR(B, visretain, R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->delobj(), "delobj");
-    }
+    // R13-R14
+    HEADER_VAR(B, delobj, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::B, in, m_pDb->dispsilh(),    "dispsilh");
-    BS_STREAMIN(bitcode::B, in, m_pDb->pellipse(),    "pellispe");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->saveimages(), "saveimages");
+    HEADER_VAR(B,  dispsilh,   R13, R2010),
+    HEADER_VAR(B,  pellipse,   R13, R2010),
+    HEADER_VAR(BS, saveimages, R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimsav(), "dimsav");
-    }
+    // R13-R14
+    HEADER_VAR(BS, dimsav, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::BS, in, m_pDb->treedepth(), "treedepth");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->lunits(),    "lunits");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->luprec(),    "luprec");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->aunits(),    "aunits");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->auprec(),    "auprec");
+    HEADER_VAR(BS, treedepth, R13, R2010),
+    HEADER_VAR(BS, lunits,    R13, R2010),
+    HEADER_VAR(BS, luprec,    R13, R2010),
+    HEADER_VAR(BS, aunits,    R13, R2010),
+    HEADER_VAR(BS, auprec,    R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->osmode(), "osmode");
-    }
+    // R13-R14
+    HEADER_VAR(BS, osmode, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::BS, in, m_pDb->attmode(), "attmode");
+    HEADER_VAR(BS, attmode, R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->coords(), "coords");
-    }
+    // R13-R14
+    HEADER_VAR(BS, coords, R13, R14),
 
     // common
-    BS_STREAMIN(bitcode::BS, in, m_pDb->pdmode(), "pdmode");
+    HEADER_VAR(BS, pdmode, R13, R2010),
 
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->pickstyle(), "pickstyle");
-    }
+    // R13-R14
+    HEADER_VAR(BS, pickstyle, R13, R14),
 
-    if(dwgVersion >= R2004)
-    {
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown12(), "unknown12");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown13(), "unknown13");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown14(), "unknown14");
-    }
+    // R2004+
+    HEADER_VAR(BL, unknown12, R2004, R2010),
+    HEADER_VAR(BL, unknown13, R2004, R2010),
+    HEADER_VAR(BL, unknown14, R2004, R2010),
 
     // common
-    BS_STREAMIN(bitcode::BS, in, m_pDb->useri1(),       "useri1");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->useri2(),       "useri2");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->useri3(),       "useri3");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->useri4(),       "useri4");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->useri5(),       "useri5");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->splinesegs(),   "splinesegs");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->surfu(),        "surfu");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->surfv(),        "surfv");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->surftype(),     "surftype");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->surftab1(),     "surftab1");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->surftab2(),     "surftab2");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->splinetype(),   "splinetype");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->shadedge(),     "shadedge");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->shadedif(),     "shadedif");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->unitmode(),     "unitmode");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->maxactvp(),     "macactvp");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->isolines(),     "isolines");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->cmljust(),      "cmljust");
-    BS_STREAMIN(bitcode::BS, in, m_pDb->textqlty(),     "textqlty");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->ltscale(),      "ltscale");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->textsize(),     "textsize");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->tracewid(),     "tracewid");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->sketchinc(),    "sketchinc");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->filletrad(),    "filletrad");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->thickness(),    "thickness");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->angbase(),      "angbase");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->pdsize(),       "pdsize");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->plinewid(),     "plinewid");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->userr1(),       "userr1");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->userr2(),       "userr2");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->userr3(),       "userr3");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->userr4(),       "userr4");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->userr5(),       "userr5");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->chamfera(),     "chamfera");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->chamferb(),     "chamferb");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->chamferc(),     "chamferc");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->chamferd(),     "chamferd");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->facetres(),     "facetres");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->cmlscale(),     "cmlscale");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->celtscale(),    "celtscale");
-    BS_STREAMIN(bitcode::TV, in, m_pDb->menuname(),     "menuname");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdcreate_day(), "tdcreate_day");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdcreate_ms(),  "tdcreate_ms");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdupdate_day(), "tdupdate_day");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdupdate_ms(),  "tdupdate_ms");
-
-    if(dwgVersion >= R2004)
-    {
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown15(), "unknown15");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown16(), "unknown16");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown17(), "unknown17");
-    }
+    HEADER_VAR(BS, useri1,       R13, R2010),
+    HEADER_VAR(BS, useri2,       R13, R2010),
+    HEADER_VAR(BS, useri3,       R13, R2010),
+    HEADER_VAR(BS, useri4,       R13, R2010),
+    HEADER_VAR(BS, useri5,       R13, R2010),
+    HEADER_VAR(BS, splinesegs,   R13, R2010),
+    HEADER_VAR(BS, surfu,        R13, R2010),
+    HEADER_VAR(BS, surfv,        R13, R2010),
+    HEADER_VAR(BS, surftype,     R13, R2010),
+    HEADER_VAR(BS, surftab1,     R13, R2010),
+    HEADER_VAR(BS, surftab2,     R13, R2010),
+    HEADER_VAR(BS, splinetype,   R13, R2010),
+    HEADER_VAR(BS, shadedge,     R13, R2010),
+    HEADER_VAR(BS, shadedif,     R13, R2010),
+    HEADER_VAR(BS, unitmode,     R13, R2010),
+    HEADER_VAR(BS, maxactvp,     R13, R2010),
+    HEADER_VAR(BS, isolines,     R13, R2010),
+    HEADER_VAR(BS, cmljust,      R13, R2010),
+    HEADER_VAR(BS, textqlty,     R13, R2010),
+    HEADER_VAR(BD, ltscale,      R13, R2010),
+    HEADER_VAR(BD, textsize,     R13, R2010),
+    HEADER_VAR(BD, tracewid,     R13, R2010),
+    HEADER_VAR(BD, sketchinc,    R13, R2010),
+    HEADER_VAR(BD, filletrad,    R13, R2010),
+    HEADER_VAR(BD, thickness,    R13, R2010),
+    HEADER_VAR(BD, angbase,      R13, R2010),
+    HEADER_VAR(BD, pdsize,       R13, R2010),
+    HEADER_VAR(BD, plinewid,     R13, R2010),
+    HEADER_VAR(BD, userr1,       R13, R2010),
+    HEADER_VAR(BD, userr2,       R13, R2010),
+    HEADER_VAR(BD, userr3,       R13, R2010),
+    HEADER_VAR(BD, userr4,       R13, R2010),
+    HEADER_VAR(BD, userr5,       R13, R2010),
+    HEADER_VAR(BD, chamfera,     R13, R2010),
+    HEADER_VAR(BD, chamferb,     R13, R2010),
+    HEADER_VAR(BD, chamferc,     R13, R2010),
+    HEADER_VAR(BD, chamferd,     R13, R2010),
+    HEADER_VAR(BD, facetres,     R13, R2010),
+    HEADER_VAR(BD, cmlscale,     R13, R2010),
+    HEADER_VAR(BD, celtscale,    R13, R2010),
+    HEADER_VAR(TV, menuname,     R13, R2010),
+    HEADER_VAR(BL, tdcreate_day, R13, R2010),
+    HEADER_VAR(BL, tdcreate_ms,  R13, R2010),
+    HEADER_VAR(BL, tdupdate_day, R13, R2010),
+    HEADER_VAR(BL, tdupdate_ms,  R13, R2010),
+
+    // R2004+
+    HEADER_VAR(BL, unknown15, R2004, R2010),
+    HEADER_VAR(BL, unknown16, R2004, R2010),
+    HEADER_VAR(BL, unknown17, R2004, R2010),
 
     // common
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdindwg_days(),    "tdindwg_days");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdindwg_ms(),      "tdindwg_ms");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdusrtimer_days(), "tdusrtimer_days");
-    BS_STREAMIN(bitcode::BL, in, m_pDb->tdusrtimer_ms(),   "tdusrtimer_ms");
-    BS_STREAMIN(bitcode::CMC, in, m_pDb->cecolor(),        "cecolor");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->handseed(),       "handseed");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->clayer(),         "clayer");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->textstyle(),      "textstyle");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->celtype(),        "celtype");
+    HEADER_VAR(BL,  tdindwg_days,    R13, R2010),
+    HEADER_VAR(BL,  tdindwg_ms,      R13, R2010),
+    HEADER_VAR(BL,  tdusrtimer_days, R13, R2010),
+    HEADER_VAR(BL,  tdusrtimer_ms,   R13, R2010),
+    HEADER_VAR(CMC, cecolor,         R13, R2010),
+    HEADER_VAR(H,   handseed,        R13, R2010),
+    HEADER_VAR(H,   clayer,          R13, R2010),
+    HEADER_VAR(H,   textstyle,       R13, R2010),
+    HEADER_VAR(H,   celtype,         R13, R2010),
 
     // R2007+
-    if(dwgVersion >= R2007)
-    {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->cmaterial(), "cmaterial");
-    }
+    HEADER_VAR(H, cmaterial, R2007, R2010),
 
-    // commmon
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->dimstyle(), "dimstyle");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->cmlstyle(), "cmlstyle");
+    // common
+    HEADER_VAR(H, dimstyle, R13, R2010),
+    HEADER_VAR(H, cmlstyle, R13, R2010),
 
     // R2000+ only
-    if(dwgVersion >= R2000)
-    {
-        BS_STREAMIN(bitcode::BD, in, m_pDb->psvpscale(), "psvpscale");
-    }
+    HEADER_VAR(BD, psvpscale, R2000, R2010),
 
     // common
-    VLOG(4) << "****** Begin PS read *****";
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->pinsbase(),  "pinsbase");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->pextmin(),   "pextmin");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->pextmax(),   "pextmax");
-    BS_STREAMIN(bitcode::RD2, in, m_pDb->plimmin(),   "plimmin");
-    BS_STREAMIN(bitcode::RD2, in, m_pDb->plimmax(),   "plimmax");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->pelevation(), "pelevation");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorg(),   "pucsorg");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsxdir(),  "pucsxdir");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsydir(),  "pucsydir");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->pucsname(),  "pucsname");
-
-    if(dwgVersion >= R2000)
-    {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->pucsbase(),      "pucsbase");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->pucsorthoview(),  "pucsorthoview");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->pucsorthoref(),  "pucsorthoref");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorgtop(),    "pucsorgtop");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorgbottom(), "pucsorgbottom");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorgleft(),   "pucsorgleft");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorgright(),  "pucsorgright");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorgfront(),  "pucsorgfront");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->pucsorgback(),   "pucsorgback");
-    }
+    HEADER_VAR(BD3, pinsbase,   R13, R2010),
+    HEADER_VAR(BD3, pextmin,    R13, R2010),
+    HEADER_VAR(BD3, pextmax,    R13, R2010),
+    HEADER_VAR(RD2, plimmin,    R13, R2010),
+    HEADER_VAR(RD2, plimmax,    R13, R2010),
+    HEADER_VAR(BD,  pelevation, R13, R2010),
+    HEADER_VAR(BD3, pucsorg,    R13, R2010),
+    HEADER_VAR(BD3, pucsxdir,   R13, R2010),
+    HEADER_VAR(BD3, pucsydir,   R13, R2010),
+    HEADER_VAR(H,   pucsname,   R13, R2010),
+
+    // R2000+
+    HEADER_VAR(H,   pucsbase,      R2000, R2010),
+    HEADER_VAR(BS,  pucsorthoview, R2000, R2010),
+    HEADER_VAR(H,   pucsorthoref,  R2000, R2010),
+    HEADER_VAR(BD3, pucsorgtop,    R2000, R2010),
+    HEADER_VAR(BD3, pucsorgbottom, R2000, R2010),
+    HEADER_VAR(BD3, pucsorgleft,   R2000, R2010),
+    HEADER_VAR(BD3, pucsorgright,  R2000, R2010),
+    HEADER_VAR(BD3, pucsorgfront,  R2000, R2010),
+    HEADER_VAR(BD3, pucsorgback,   R2000, R2010),
 
     // common
-    VLOG(4) << "****** Begin MS read *****";
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->insbase(),  "insbase");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->extmin(),   "extmin");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->extmax(),   "extmax");
-    BS_STREAMIN(bitcode::RD2, in, m_pDb->limmin(),   "limmin");
-    BS_STREAMIN(bitcode::RD2, in, m_pDb->limmax(),   "limmax");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->elevation(), "elevation");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorg(),   "ucsorg");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsxdir(),  "ucsxdir");
-    BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsydir(),  "ucsydir");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->ucsname(),  "ucsname");
-
-    if(dwgVersion >= R2000)
-    {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->ucsbase(),      "ucsbase");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->ucsorthoview(),  "ucsorthoview");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->ucsorthoref(),  "ucsorthoref");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorgtop(),    "ucsorgtop");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorgbottom(), "ucsorgbottom");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorgleft(),   "ucsorgleft");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorgright(),  "ucsorgright");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorgfront(),  "ucsorgfront");
-        BS_STREAMIN(bitcode::BD3, in, m_pDb->ucsorgback(),   "ucsorgback");
-        BS_STREAMIN(bitcode::TV, in, m_pDb->dimpost(),       "dimpost");
-        BS_STREAMIN(bitcode::TV, in, m_pDb->dimapost(),      "dimapost");
-    }
-
-    if(dwgVersion == R13 || dwgVersion == R14)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimtol(),     "dimtol");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimlim(),     "dimlim");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimtih(),     "dimtih");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimtoh(),     "dimtoh");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimse1(),     "dimse1");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimse2(),     "dimse2");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimalt(),     "dimalt");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimtofl(),    "dimtofl");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimsah(),     "dimsah");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimtix(),     "dimtix");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimsoxd(),    "dimsoxd");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimaltd(),   "dimaltd");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimzin(),    "dimzin");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimsd1(),     "dimsd1");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimsd2(),     "dimsd2");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimtolj(),   "dimtolj");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimjust(),   "dimjust");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimfit(),    "dimfit");
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimupt(),     "dimupt");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimtzin(),   "dimtzin");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimaltz(),   "dimaltz");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimalttz(),  "dimalttz");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimtad(),    "dimtad");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimunit(),   "dimunit");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimaunit(),  "dimaunit");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimdec(),    "dimdec");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimtdec(),   "dimtdec");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimaltu(),   "dimaltu");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimalttd(),  "dimalttd");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimtxsty(), "dimtxsty");
-    }
+    HEADER_VAR(BD3, insbase,   R13, R2010),
+    HEADER_VAR(BD3, extmin,    R13, R2010),
+    HEADER_VAR(BD3, extmax,    R13, R2010),
+    HEADER_VAR(RD2, limmin,    R13, R2010),
+    HEADER_VAR(RD2, limmax,    R13, R2010),
+    HEADER_VAR(BD,  elevation, R13, R2010),
+    HEADER_VAR(BD3, ucsorg,    R13, R2010),
+    HEADER_VAR(BD3, ucsxdir,   R13, R2010),
+    HEADER_VAR(BD3, ucsydir,   R13, R2010),
+    HEADER_VAR(H,   ucsname,   R13, R2010),
+
+    // R2000+
+    HEADER_VAR(H,   ucsbase,      R2000, R2010),
+    HEADER_VAR(BS,  ucsorthoview, R2000, R2010),
+    HEADER_VAR(H,   ucsorthoref,  R2000, R2010),
+    HEADER_VAR(BD3, ucsorgtop,    R2000, R2010),
+    HEADER_VAR(BD3, ucsorgbottom, R2000, R2010),
+    HEADER_VAR(BD3, ucsorgleft,   R2000, R2010),
+    HEADER_VAR(BD3, ucsorgright,  R2000, R2010),
+    HEADER_VAR(BD3, ucsorgfront,  R2000, R2010),
+    HEADER_VAR(BD3, ucsorgback,   R2000, R2010),
+    HEADER_VAR(TV,  dimpost,      R2000, R2010),
+    HEADER_VAR(TV,  dimapost,     R2000, R2010),
+
+    // R13-R14
+    HEADER_VAR(B,  dimtol,   R13, R14),
+    HEADER_VAR(B,  dimlim,   R13, R14),
+    HEADER_VAR(B,  dimtih,   R13, R14),
+    HEADER_VAR(B,  dimtoh,   R13, R14),
+    HEADER_VAR(B,  dimse1,   R13, R14),
+    HEADER_VAR(B,  dimse2,   R13, R14),
+    HEADER_VAR(B,  dimalt,   R13, R14),
+    HEADER_VAR(B,  dimtofl,  R13, R14),
+    HEADER_VAR(B,  dimsah,   R13, R14),
+    HEADER_VAR(B,  dimtix,   R13, R14),
+    HEADER_VAR(B,  dimsoxd,  R13, R14),
+    HEADER_VAR(RC, dimaltd,  R13, R14),
+    HEADER_VAR(RC, dimzin,   R13, R14),
+    HEADER_VAR(B,  dimsd1,   R13, R14),
+    HEADER_VAR(B,  dimsd2,   R13, R14),
+    HEADER_VAR(RC, dimtolj,  R13, R14),
+    HEADER_VAR(RC, dimjust,  R13, R14),
+    HEADER_VAR(RC, dimfit,   R13, R14),
+    HEADER_VAR(B,  dimupt,   R13, R14),
+    HEADER_VAR(RC, dimtzin,  R13, R14),
+    HEADER_VAR(RC, dimaltz,  R13, R14),
+    HEADER_VAR(RC, dimalttz, R13, R14),
+    HEADER_VAR(RC, dimtad,   R13, R14),
+    HEADER_VAR(BS, dimunit,  R13, R14),
+    HEADER_VAR(BS, dimaunit, R13, R14),
+    HEADER_VAR(BS, dimdec,   R13, R14),
+    HEADER_VAR(BS, dimtdec,  R13, R14),
+    HEADER_VAR(BS, dimaltu,  R13, R14),
+    HEADER_VAR(BS, dimalttd, R13, R14),
+    HEADER_VAR(H,  dimtxsty, R13, R14),
 
     ////////////////////////////////////////////////////////////////////////////
     // common
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimscale(), "dimscale")
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimasz(),   "dimasz");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimexo(),   "dimexo");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimdli(),   "dimdli");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimexe(),   "dimexe");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimrnd(),   "dimrnd");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimdle(),   "dimdle");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimtp(),    "dimtp");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimtm(),    "dimtm");
+    HEADER_VAR(BD, dimscale, R13, R2010),
+    HEADER_VAR(BD, dimasz,   R13, R2010),
+    HEADER_VAR(BD, dimexo,   R13, R2010),
+    HEADER_VAR(BD, dimdli,   R13, R2010),
+    HEADER_VAR(BD, dimexe,   R13, R2010),
+    HEADER_VAR(BD, dimrnd,   R13, R2010),
+    HEADER_VAR(BD, dimdle,   R13, R2010),
+    HEADER_VAR(BD, dimtp,    R13, R2010),
+    HEADER_VAR(BD, dimtm,    R13, R2010),
 
     // R2007+
-    if(dwgVersion >= R2007)
-    {
-        BS_STREAMIN(bitcode::BD, in, m_pDb-> dimfxl(),      "dimfxl");
-        BS_STREAMIN(bitcode::BD, in, m_pDb-> dimjogang(),   "dimjogang");
-        BS_STREAMIN(bitcode::BS, in, m_pDb-> dimtfill(),    "dimtfill");
-        BS_STREAMIN(bitcode::CMC, in, m_pDb->dimtfillclr(), "dimtfillclr");
-    }
+    HEADER_VAR(BD,  dimfxl,      R2007, R2010),
+    HEADER_VAR(BD,  dimjogang,   R2007, R2010),
+    HEADER_VAR(BS,  dimtfill,    R2007, R2010),
+    HEADER_VAR(CMC, dimtfillclr, R2007, R2010),
 
     // R2000+
-    if(dwgVersion >= R2000)
-    {
-        BS_STREAMIN(bitcode::B, in, m_pDb-> dimtol(),  "dimtol");
-        BS_STREAMIN(bitcode::B, in, m_pDb-> dimlim(),  "dimlim");
-        BS_STREAMIN(bitcode::B, in, m_pDb-> dimtih(),  "dimtih");
-        BS_STREAMIN(bitcode::B, in, m_pDb-> dimtoh(),  "dimtoh");
-        BS_STREAMIN(bitcode::B, in, m_pDb-> dimse1(),  "dimse1");
-        BS_STREAMIN(bitcode::B, in, m_pDb-> dimse2(),  "dimse2");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimtad(),  "dimtad");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimzin(),  "dimzin");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimazin(), "dimazin");
-    }
+    HEADER_VAR(B,  dimtol,  R2000, R2010),
+    HEADER_VAR(B,  dimlim,  R2000, R2010),
+    HEADER_VAR(B,  dimtih,  R2000, R2010),
+    HEADER_VAR(B,  dimtoh,  R2000, R2010),
+    HEADER_VAR(B,  dimse1,  R2000, R2010),
+    HEADER_VAR(B,  dimse2,  R2000, R2010),
+    HEADER_VAR(BS, dimtad,  R2000, R2010),
+    HEADER_VAR(BS, dimzin,  R2000, R2010),
+    HEADER_VAR(BS, dimazin, R2000, R2010),
 
     // R2007+
-    if(dwgVersion >= R2007)
-    {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimarcsym(), "dimarcsym");
-    }
+    HEADER_VAR(BS, dimarcsym, R2007, R2010),
 
     // common
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimtxt(),  "dimtxt");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimcen(),  "dimcen");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimtsz(),  "dimtsz");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimaltf(), "dimaltf");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimlfac(), "dimlfac");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimtvp(),  "dimtvp");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimtfac(), "dimtfac");
-    BS_STREAMIN(bitcode::BD, in, m_pDb->dimgap(),  "dimgap");
+    HEADER_VAR(BD, dimtxt,  R13, R2010),
+    HEADER_VAR(BD, dimcen,  R13, R2010),
+    HEADER_VAR(BD, dimtsz,  R13, R2010),
+    HEADER_VAR(BD, dimaltf, R13, R2010),
+    HEADER_VAR(BD, dimlfac, R13, R2010),
+    HEADER_VAR(BD, dimtvp,  R13, R2010),
+    HEADER_VAR(BD, dimtfac, R13, R2010),
+    HEADER_VAR(BD, dimgap,  R13, R2010),
 
     // R13-R14
-    if(dwgVersion == R13 || dwgVersion == R14)
+    HEADER_VAR(T, dimpost,  R13, R14),
+    HEADER_VAR(T, dimapost, R13, R14),
+    HEADER_VAR(T, dimblk,   R13, R14),
+    HEADER_VAR(T, dimblk1,  R13, R14),
+    HEADER_VAR(T, dimblk2,  R13, R14),
+
+    // R2000+
+    HEADER_VAR(BD, dimaltrnd, R2000, R2010),
+    HEADER_VAR(B,  dimalt,    R2000, R2010),
+    HEADER_VAR(BS, dimaltd,   R2000, R2010),
+    HEADER_VAR(B,  dimtofl,   R2000, R2010),
+    HEADER_VAR(B,  dimsah,    R2000, R2010),
+    HEADER_VAR(B,  dimtix,    R2000, R2010),
+    HEADER_VAR(B,  dimsoxd,   R2000, R2010),
+
+    // common
+    HEADER_VAR(CMC, dimclrd, R13, R2010),
+    HEADER_VAR(CMC, dimclre, R13, R2010),
+    HEADER_VAR(CMC, dimclrt, R13, R2010),
+
+    // R2000+
+    HEADER_VAR(BS, dimadec,  R2000, R2010),
+    HEADER_VAR(BS, dimdec,   R2000, R2010),
+    HEADER_VAR(BS, dimtdec,  R2000, R2010),
+    HEADER_VAR(BS, dimaltu,  R2000, R2010),
+    HEADER_VAR(BS, dimalttd, R2000, R2010),
+    HEADER_VAR(BS, dimaunit, R2000, R2010),
+    HEADER_VAR(BS, dimfrac,  R2000, R2010),
+    HEADER_VAR(BS, dimlunit, R2000, R2010),
+    HEADER_VAR(BS, dimdsep,  R2000, R2010),
+    HEADER_VAR(BS, dimtmove, R2000, R2010),
+    HEADER_VAR(BS, dimjust,  R2000, R2010),
+    HEADER_VAR(B,  dimsd1,   R2000, R2010),
+    HEADER_VAR(B,  dimsd2,   R2000, R2010),
+    HEADER_VAR(BS, dimtolj,  R2000, R2010),
+    HEADER_VAR(BS, dimtzin,  R2000, R2010),
+    HEADER_VAR(BS, dimaltz,  R2000, R2010),
+    HEADER_VAR(BS, dimalttz, R2000, R2010),
+    HEADER_VAR(B,  dimupt,   R2000, R2010),
+    HEADER_VAR(BS, dimatfit, R2000, R2010),
+
+    // R2007+
+    HEADER_VAR(B, dimfxlon, R2007, R2010),
+
+    // R2010+, not decoded yet
+    //        BS_STREAMIN(bitcode::B,  in, pHdr->dimtxtdirection(), "dimtxtdirection");
+    //        BS_STREAMIN(bitcode::BD, in, pHdr->dimaltmzf(),       "dimaltmzf");
+    //        BS_STREAMIN(bitcode::T,  in, pHdr->dimaltmzs(),       "dimaltmzs");
+    //        BS_STREAMIN(bitcode::BD, in, pHdr->dimmzf(),          "dimmzf");
+    //        BS_STREAMIN(bitcode::T,  in, pHdr->dimmzs(),          "dimmzs");
+
+    // R2000+
+    HEADER_VAR(H, dimtxsty,  R2000, R2010),
+    HEADER_VAR(H, dimldrblk, R2000, R2010),
+    HEADER_VAR(H, dimblkId,  R2000, R2010),
+    HEADER_VAR(H, dimblk1Id, R2000, R2010),
+    HEADER_VAR(H, dimblk2Id, R2000, R2010),
+
+    // R2007+
+    HEADER_VAR(H, dimltype, R2007, R2010),
+    HEADER_VAR(H, dimltex1, R2007, R2010),
+    HEADER_VAR(H, dimltex2, R2007, R2010),
+
+    // R2000+
+    HEADER_VAR(BS, dimlwd, R2000, R2010),
+    HEADER_VAR(BS, dimlwe, R2000, R2010),
+
+    // common
+    HEADER_VAR(H, blockCtrlId,    R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, layerCtrlId,    R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, styleCtrlId,    R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, linetypeCtrlId, R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, viewCtrlId,     R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, ucsCtrlId,      R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, vportCtrlId,    R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, appidCtrlId,    R13, R2010), // CONTROL OBJECT
+    HEADER_VAR(H, dimstyleCtrlId, R13, R2010), // CONTROL OBJECT
+
+    // R13-R15
+    HEADER_VAR(H, viewport, R13, R2000), // ENTITY HEADER CONTROL OBJECT
+
+    // common
+    HEADER_VAR(H, dictionaryGroupId,      R13, R2010),
+    HEADER_VAR(H, dictionaryMLineStyleId, R13, R2010),
+    HEADER_VAR(H, dictionaryNamedObjsId,  R13, R2010),
+
+    // R2000+
+    HEADER_VAR(BS, tstackalign,              R2000, R2010),
+    HEADER_VAR(BS, tstacksize,               R2000, R2010),
+    HEADER_VAR(TV, hyperlinkbase,            R2000, R2010),
+    HEADER_VAR(TV, stylesheet,               R2000, R2010),
+    HEADER_VAR(H,  dictionaryLayoutsId,      R2000, R2010), // (LAYOUTS)
+    HEADER_VAR(H,  dictionaryPlotSettingsId, R2000, R2010), // (PLOTSETTINGS)
+    HEADER_VAR(H,  dictionaryPlotStylesId,   R2000, R2010), // (PLOTSTYLES)
+
+    // R2004+
+    HEADER_VAR(H, dictionaryMaterialsId, R2004, R2010), // (MATERIALS)
+    HEADER_VAR(H, dictionaryColorsId,    R2004, R2010), // (COLORS)
+
+    // R2007+
+    HEADER_VAR(H, dictionaryVisualStyleId, R2007, R2010), // (VISUALSTYLE)
+
+    // R2000+
+    HEADER_VAR(BL, flags, R2000, R2010),
+    //                      CELWEIGHT       Flags & 0x001F
+    //                      ENDCAPS         Flags & 0x0060
+    //                      JOINSTYLE       Flags & 0x0180
+    //                      LWDISPLAY       !(Flags & 0x0200)
+    //                      XEDIT           !(Flags & 0x0400)
+    //                      EXTNAMES        Flags & 0x0800
+    //                      PSTYLEMODE      Flags & 0x2000
+    //                      OLESTARTUP      Flags & 0x4000
+    HEADER_VAR(BS, insunits,        R2000, R2010),
+    HEADER_VAR(BS, cepsntype,       R2000, R2010),
+    HEADER_VAR_IF(H, cpsnid, R2000, R2010, 3), // only present if cepsntype == 3
+    HEADER_VAR(TV, fingerprintguid, R2000, R2010),
+    HEADER_VAR(TV, versionguid,     R2000, R2010),
+
+    // R2004+
+    HEADER_VAR(RC, sortents,            R2004, R2010),
+    HEADER_VAR(RC, indexctl,            R2004, R2010),
+    HEADER_VAR(RC, hidetext,            R2004, R2010),
+    HEADER_VAR(RC, xclipframe,          R2004, R2010),
+    HEADER_VAR(RC, dimassoc,            R2004, R2010),
+    HEADER_VAR(RC, halogap,             R2004, R2010),
+    HEADER_VAR(BS, obscuredcolor,       R2004, R2010),
+    HEADER_VAR(BS, intersectioncolor,   R2004, R2010),
+    HEADER_VAR(RC, obscuredltype,       R2004, R2010),
+    HEADER_VAR(RC, intersectiondisplay, R2004, R2010),
+    HEADER_VAR(TV, projectname,         R2004, R2010),
+
+    // common
+    HEADER_VAR(H, block_recordPsId,  R13, R2010), // (*PAPER_SPACE)
+    HEADER_VAR(H, block_recordMsId,  R13, R2010), // (*MODEL_SPACE)
+    HEADER_VAR(H, ltypeByLayerId,    R13, R2010), // (BYLAYER)
+    HEADER_VAR(H, ltypeByBlockId,    R13, R2010), // (BYBLOCK)
+    HEADER_VAR(H, ltypeContinuousId, R13, R2010), // (CONTINUOUS)
+
+    // R2007+
+    HEADER_VAR(B,   cameradisplay,      R2007, R2010),
+    HEADER_VAR(BL,  unknown21,          R2007, R2010),
+    HEADER_VAR(BL,  unknown22,          R2007, R2010),
+    HEADER_VAR(BD,  unknown23,          R2007, R2010),
+    HEADER_VAR(BD,  stepspersec,        R2007, R2010),
+    HEADER_VAR(BD,  stepsize,           R2007, R2010),
+    HEADER_VAR(BD,  dwfprec3d,          R2007, R2010),
+    HEADER_VAR(BD,  lenslength,         R2007, R2010),
+    HEADER_VAR(BD,  cameraheight,       R2007, R2010),
+    HEADER_VAR(RC,  solidhist,          R2007, R2010),
+    HEADER_VAR(RC,  showhist,           R2007, R2010),
+    HEADER_VAR(BD,  psolwidth,          R2007, R2010),
+    HEADER_VAR(BD,  psolheight,         R2007, R2010),
+    HEADER_VAR(BD,  loftang1,           R2007, R2010),
+    HEADER_VAR(BD,  loftang2,           R2007, R2010),
+    HEADER_VAR(BD,  loftmag1,           R2007, R2010),
+    HEADER_VAR(BD,  logtmag2,           R2007, R2010),
+    HEADER_VAR(BS,  loftparam,          R2007, R2010),
+    HEADER_VAR(RC,  loftnormals,        R2007, R2010),
+    HEADER_VAR(BD,  latitude,           R2007, R2010),
+    HEADER_VAR(BD,  longitude,          R2007, R2010),
+    HEADER_VAR(BD,  northdirection,     R2007, R2010),
+    HEADER_VAR(BL,  timezone,           R2007, R2010),
+    HEADER_VAR(RC,  lightglyphdisplay,  R2007, R2010),
+    HEADER_VAR(RC,  tilemodelightsynch, R2007, R2010),
+    HEADER_VAR(RC,  dwfframe,           R2007, R2010),
+    HEADER_VAR(RC,  dgnframe,           R2007, R2010),
+    HEADER_VAR(B,   unknown47,          R2007, R2010),
+    HEADER_VAR(CMC, interferecolor,     R2007, R2010),
+    HEADER_VAR(H,   interfereobjvsId,   R2007, R2010),
+    HEADER_VAR(H,   interferevpvsId,    R2007, R2010),
+    HEADER_VAR(H,   dragvsId,           R2007, R2010),
+    HEADER_VAR(RC,  cshadow,            R2007, R2010),
+    HEADER_VAR(BD,  unknown53,          R2007, R2010),
+
+    // R14+
+    HEADER_VAR(BS, unknown54, R14, R2010), // short(type 5 / 6 only)  these do not seem to be required,
+    HEADER_VAR(BS, unknown55, R14, R2010), // short(type 5 / 6 only)  even for type 5.
+    HEADER_VAR(BS, unknown56, R14, R2010), // short(type 5 / 6 only)
+    HEADER_VAR(BS, unknown57, R14, R2010), // short(type 5 / 6 only)
+
+
+};
+
+#undef HEADER_VAR
+#undef HEADER_VAR_IF
+#undef HEADER_VAR_READ
+
+const size_t numHeaderVarFields = sizeof(headerVarFields) / sizeof(headerVarFields[0]);
+
+// Indices of the fields stored by each version, so decoding doesn't test
+// every field's version range.
+struct FieldPlans
+{
+    std::vector<uint16_t> byVersion[R2010 + 1];
+
+    FieldPlans()
     {
-        BS_STREAMIN(bitcode::T, in, m_pDb->dimpost(),  "dimpost");
-        BS_STREAMIN(bitcode::T, in, m_pDb->dimapost(), "dimapost");
-        BS_STREAMIN(bitcode::T, in, m_pDb->dimblk(),   "dimblk");
-        BS_STREAMIN(bitcode::T, in, m_pDb->dimblk1(),  "dimblk1");
-        BS_STREAMIN(bitcode::T, in, m_pDb->dimblk2(),  "dimblk2");
+        for(int v = R13; v <= R2010; ++v)
+        {
+            for(size_t i = 0; i < numHeaderVarFields; ++i)
+            {
+                if(v >= headerVarFields[i].firstVersion &&
+                   v <= headerVarFields[i].lastVersion)
+                {
+                    byVersion[v].push_back((uint16_t) i);
+                }
+            }
+        }
     }
+};
 
-    // R2000+
-    if(dwgVersion >= R2000)
+// defined after headerVarFields, they are initialized in that order
+const FieldPlans fieldPlans;
+} // namespace
+
+OcBsDatabaseHeaderVars::OcBsDatabaseHeaderVars(void)
+    : m_fileCRC(0)
+{
+    VLOG_FUNC_NAME;
+}
+
+
+OcBsDatabaseHeaderVars::~OcBsDatabaseHeaderVars(void)
+{
+    VLOG_FUNC_NAME;
+}
+
+size_t OcBsDatabaseHeaderVars::NumFields(void)
+{
+    VLOG_FUNC_NAME;
+    return numHeaderVarFields;
+}
+
+const OcBsDatabaseHeaderVars::Field & OcBsDatabaseHeaderVars::GetField(size_t index)
+{
+    VLOG_FUNC_NAME;
+    DCHECK(index < numHeaderVarFields) << "header variable index out of range";
+    return headerVarFields[index];
+}
+
+bool OcBsDatabaseHeaderVars::Select(const std::string & name)
+{
+    VLOG_FUNC_NAME;
+    bool bFound = false;
+
+    for(size_t i = 0; i < numHeaderVarFields; ++i)
     {
-        BS_STREAMIN(bitcode::BD, in, m_pDb->dimaltrnd(), "dimaltrnd");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimalt(),    "dimalt");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimaltd(),   "dimaltd");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimtofl(),   "dimtofl");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimsah(),    "dimsah");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimtix(),    "dimtix");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimsoxd(),   "dimsoxd");
+        if(name == headerVarFields[i].name)
+        {
+            if(m_selected.empty())
+            {
+                m_selected.resize(numHeaderVarFields, false);
+            }
+
+            m_selected[i] = true;
+            bFound = true;
+        }
     }
 
-    // common
-    BS_STREAMIN(bitcode::CMC, in, m_pDb->dimclrd(), "dimclrd");
-    BS_STREAMIN(bitcode::CMC, in, m_pDb->dimclre(), "dimclre");
-    BS_STREAMIN(bitcode::CMC, in, m_pDb->dimclrt(), "dimclrt");
+    return bFound;
+}
 
-    // R2000+
-    if(dwgVersion >= R2000)
-    {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimadec(),  "dimadec");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimdec(),   "dimdec");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimtdec(),  "dimtdec");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimaltu(),  "dimaltu");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimalttd(), "dimalttd");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimaunit(), "dimaunit");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimfrac(),  "dimfrac");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimlunit(), "dimlunit");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimdsep(),  "dimdsep");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimtmove(), "dimtmove");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimjust(),  "dimjust");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimsd1(),   "dimsd1");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimsd2(),   "dimsd2");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimtolj(),  "dimtolj");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimtzin(),  "dimtzin");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimaltz(),  "dimaltz");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimalttz(), "dimalttz");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->dimupt(),   "dimupt");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimatfit(), "dimatfit");
+void OcBsDatabaseHeaderVars::SelectAll(void)
+{
+    VLOG_FUNC_NAME;
+    m_selected.clear();
+    m_targets.clear();
+}
+
+bool OcBsDatabaseHeaderVars::Select(const std::string & name, OcGePoint3D & value)
+{
+    VLOG_FUNC_NAME;
+    return SelectInto(name, eBD3, &value);
+}
+
+bool OcBsDatabaseHeaderVars::Select(const std::string & name, int16_t & value)
+{
+    VLOG_FUNC_NAME;
+    return SelectInto(name, eBS, &value);
+}
+
+bool OcBsDatabaseHeaderVars::Select(const std::string & name, int32_t & value)
+{
+    VLOG_FUNC_NAME;
+    return SelectInto(name, eBL, &value);
+}
+
+bool OcBsDatabaseHeaderVars::SelectInto(const std::string & name, Type type, void * pValue)
+{
+    VLOG_FUNC_NAME;
+
+    // every entry of the variable must be stored as type
+    for(size_t i = 0; i < numHeaderVarFields; ++i)
+    {
+        if(name == headerVarFields[i].name && headerVarFields[i].type != type)
+        {
+            return false;
+        }
     }
 
-    // R2007+
-    if(dwgVersion >= R2007)
+    if(!Select(name))
     {
-        BS_STREAMIN(bitcode::B, in, m_pDb->dimfxlon(), "dimfxlog");
+        return false;
     }
 
-    if(dwgVersion >= R2010)
+    if(m_targets.empty())
     {
-        //        BS_STREAMIN(bitcode::B,  in, pHdr->dimtxtdirection(), "dimtxtdirection");
-        //        BS_STREAMIN(bitcode::BD, in, pHdr->dimaltmzf(),       "dimaltmzf");
-        //        BS_STREAMIN(bitcode::T,  in, pHdr->dimaltmzs(),       "dimaltmzs");
-        //        BS_STREAMIN(bitcode::BD, in, pHdr->dimmzf(),          "dimmzf");
-        //        BS_STREAMIN(bitcode::T,  in, pHdr->dimmzs(),          "dimmzs");
+        m_targets.resize(numHeaderVarFields);
     }
 
-    // R2000+
-    if(dwgVersion >= R2000)
+    for(size_t i = 0; i < numHeaderVarFields; ++i)
     {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimtxsty(),  "dimtxsty");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimldrblk(), "dimldrblk");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimblkId(),  "dimblkId");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimblk1Id(), "dimblk1Id");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimblk2Id(), "dimblk2Id");
+        if(name == headerVarFields[i].name)
+        {
+            m_targets[i].type = type;
+            m_targets[i].pValue = pValue;
+        }
     }
 
-    // R2007+
-    if(dwgVersion >= R2007)
+    return true;
+}
+
+bool OcBsDatabaseHeaderVars::NeedsDatabase(void) const
+{
+    VLOG_FUNC_NAME;
+
+    if(m_selected.empty() || m_targets.empty())
     {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimltype(),  "dimltype");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimltex1(),  "dimltex1");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dimltex2(),  "dimltex2");
+        return true;
     }
 
-    // R2000+
-    if(dwgVersion >= R2000)
+    for(size_t i = 0; i < numHeaderVarFields; ++i)
     {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimlwd(), "dimlwd");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->dimlwe(), "dimlwe");
+        if(m_selected[i] && !m_targets[i].pValue)
+        {
+            return true;
+        }
     }
 
-    // common
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->blockCtrlId(),    "blockCtrlId");  // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->layerCtrlId(),    "layerCtrlId");    // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->styleCtrlId(),    "styleCtrlId");    // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->linetypeCtrlId(), "linetypeCtrlId"); // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->viewCtrlId(),     "viewCtrlId");     // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->ucsCtrlId(),      "ucsCtrlId");      // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->vportCtrlId(),    "vportCtrlId");    // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->appidCtrlId(),    "appidCtrlId");    // CONTROL OBJECT
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->dimstyleCtrlId(), "dimstyleCtrlId"); // CONTROL OBJECT
+    return false;
+}
 
-    // R13-R15
-    if(dwgVersion == R13 || dwgVersion == R14 || dwgVersion == R2000)
+// Decodes a field selected with a value into that value.
+template<DWG_VERSION V>
+uint64_t OcBsDatabaseHeaderVars::ReadTarget(OcBsStreamIn & in, const Target & target)
+{
+    VLOG_FUNC_NAME;
+
+    switch(target.type)
+    {
+    case eBS:
     {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->viewport(), "viewport"); // ENTITY HEADER CONTROL OBJECT
+        bitcode::BS value;
+        Decode<V>(in, value);
+        int16_t & var = *(int16_t *) target.pValue;
+        var = FieldCast<int16_t>::From(value);
+        return TraceValue(var);
     }
 
-    // common
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryGroupId(),      "group dictionary Id");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryMLineStyleId(), "mline style dict Id");
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryNamedObjsId(),  "named objects dict Id");
+    case eBL:
+    {
+        bitcode::BL value;
+        Decode<V>(in, value);
+        int32_t & var = *(int32_t *) target.pValue;
+        var = FieldCast<int32_t>::From(value);
+        return TraceValue(var);
+    }
 
-    // R2000+
-    if(dwgVersion >= R2000)
+    case eBD3:
     {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->tstackalign(),   "tstackalign");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->tstacksize(),    "tstacksize");
-        BS_STREAMIN(bitcode::TV, in, m_pDb->hyperlinkbase(), "hyperlinkbase");
-        BS_STREAMIN(bitcode::TV, in, m_pDb->stylesheet(),    "stylesheet")
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryLayoutsId(),      "layouts dict Id");       // (LAYOUTS)
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryPlotSettingsId(), "plot settings dict Id"); // (PLOTSETTINGS)
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryPlotStylesId(),   "plot styles dict Id");        // (PLOTSTYLES)
+        bitcode::BD3 value;
+        Decode<V>(in, value);
+        OcGePoint3D & var = *(OcGePoint3D *) target.pValue;
+        var = FieldCast<OcGePoint3D>::From(value);
+        return TraceValue(var);
     }
 
-    // R2004+
-    if(dwgVersion >= R2004)
+    default:
+        DCHECK(false) << "header variable target of unsupported type";
+        return SkipField<V>(in, target.type);
+    }
+}
+
+// Moves past a field without storing it. Only the bits needed to find the
+// field's length are decoded. Integer values are returned for fields
+// another field's presence depends on.
+template<DWG_VERSION V>
+uint64_t OcBsDatabaseHeaderVars::SkipField(OcBsStreamIn & in, Type type)
+{
+    VLOG_FUNC_NAME;
+
+    switch(type)
+    {
+    case eB:
+        return in.ReadBits(1);
+
+    case eBS:
     {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryMaterialsId(), "materials dict Id");     // (MATERIALS)
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryColorsId(), "colors dict Id");        // (COLORS)
+        bitcode::BS bs;
+        in >> bs;
+        return (uint64_t) bs.t;
     }
 
-    // R2007+
-    if(dwgVersion >= R2007)
+    case eBL:
     {
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dictionaryVisualStyleId(), "visual style dict Id");  // (VISUALSTYLE)
+        bitcode::BL bl;
+        in >> bl;
+        return (uint64_t) bl.t;
     }
 
-    // R2000+
-    if(dwgVersion >= R2000)
-    {
-        BS_STREAMIN(bitcode::BL, in, m_pDb->flags(), "flags");
-        //                      CELWEIGHT       Flags & 0x001F
-        //                      ENDCAPS         Flags & 0x0060
-        //                      JOINSTYLE       Flags & 0x0180
-        //                      LWDISPLAY       !(Flags & 0x0200)
-        //                      XEDIT           !(Flags & 0x0400)
-        //                      EXTNAMES        Flags & 0x0800
-        //                      PSTYLEMODE      Flags & 0x2000
-        //                      OLESTARTUP      Flags & 0x4000
-        BS_STREAMIN(bitcode::BS, in, m_pDb->insunits(),  "insunits");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->cepsntype(), "cepsntype");
-
-        if(m_pDb->cepsntype() == 3)
+    case eRC:
+        return in.ReadBits(8);
+
+    case eBD:
+        SkipBD(in);
+        break;
+
+    case eRD2:
+        in.SkipBits(128);
+        break;
+
+    case eBD3:
+        SkipBD(in);
+        SkipBD(in);
+        SkipBD(in);
+        break;
+
+    case eT:
+        SkipText(in, 8);
+        break;
+
+    case eTV:
+        SkipTV<V>(in);
+        break;
+
+    case eCMC:
+    {
+        bitcode::BS index;
+        in >> index;
+
+        if(V >= R2004)
         {
-            // cpsnid only present if m_cepsntype == 3
-            BS_STREAMIN(OcDbObjectId, in, m_pDb->cpsnid(), "cpsnid");
+            bitcode::BL rgb;
+            in >> rgb;
+            uint64_t colorByte = in.ReadBits(8);
+
+            if(colorByte & 1)
+            {
+                SkipTV<V>(in);  // color name
+            }
+
+            if(colorByte & 2)
+            {
+                SkipTV<V>(in);  // book name
+            }
         }
 
-        BS_STREAMIN(bitcode::TV, in, m_pDb->fingerprintguid(), "fingerprintguid");
-        BS_STREAMIN(bitcode::TV, in, m_pDb->versionguid(), "versionguid");
+        break;
     }
 
-    // R2004+
-    if(dwgVersion >= R2004)
+    case eH:
     {
-        BS_STREAMIN(bitcode::RC, in, m_pDb->sortents(),          "sortents");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->indexctl(),          "indexctl");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->hidetext(),          "hidetext");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->xclipframe(),        "xclipframe");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dimassoc(),          "dimassoc");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->halogap(),           "halogap");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->obscuredcolor(),     "obscuredcolor");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->intersectioncolor(), "intersectioncolor");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->obscuredltype(),     "obscuredltype");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->intersectiondisplay(), "intersectiondisplay")
-        BS_STREAMIN(bitcode::TV, in, m_pDb->projectname(),       "projectname");
+        // 4 bit code followed by a 4 bit byte count
+        uint64_t codeAndCounter = in.ReadBits(8);
+        in.SkipBits((codeAndCounter & 0x0f) * CHAR_BIT);
+        break;
+    }
     }
 
-    // common
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->block_recordPsId(), "ps block record Id");  // (*PAPER_SPACE)
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->block_recordMsId(), "ms block record Id");  // (*MODEL_SPACE)
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->ltypeByLayerId(),   "ltype bylayer id");         // (BYLAYER)
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->ltypeByBlockId(),   "ltype byblock id");         // (BYBLOCK)
-    BS_STREAMIN(OcDbObjectId, in, m_pDb->ltypeContinuousId(), "ltype continuous LT id");         // (CONTINUOUS)
+    return 0;
+}
 
-    // R2007+
-    if(dwgVersion >= R2007)
-    {
-        BS_STREAMIN(bitcode::B,  in, m_pDb->cameradisplay(),     "cameradisplay");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown21(),         "unknown21");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->unknown22(),         "unknown22");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->unknown23(),         "unknown23");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->stepspersec(),       "stepspersec");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->stepsize(),          "stepsize");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->dwfprec3d(),         "dwfprec3d");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->lenslength(),        "lenslength");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->cameraheight(),      "cameraheight");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->solidhist(),         "solidhist");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->showhist(),          "showhist");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->psolwidth(),         "psolwidth");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->psolheight(),        "psolheight");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->loftang1(),          "loftang1");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->loftang2(),          "loftang2");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->loftmag1(),          "loftmag1");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->logtmag2(),          "loftmag2");
-        BS_STREAMIN(bitcode::BS, in, m_pDb->loftparam(),         "loftparam");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->loftnormals(),       "loftnormals");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->latitude(),          "latitude");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->longitude(),         "longitude");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->northdirection(),    "northdirection");
-        BS_STREAMIN(bitcode::BL, in, m_pDb->timezone(),          "timezone");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->lightglyphdisplay(), "lightglyphdisplay");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->tilemodelightsynch(), "tilemodelightsynch");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dwfframe(),          "dwfframe");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->dgnframe(),          "dgnframe");
-        BS_STREAMIN(bitcode::B,  in, m_pDb->unknown47(),         "unknown47");
-        BS_STREAMIN(bitcode::CMC, in, m_pDb->interferecolor(),   "interferecolor");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->interfereobjvsId(), "interfereobjvsId");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->interferevpvsId(),  "interferevpvsId");
-        BS_STREAMIN(OcDbObjectId, in, m_pDb->dragvsId(),         "dragvsId");
-        BS_STREAMIN(bitcode::RC, in, m_pDb->cshadow(),           "cshadow");
-        BS_STREAMIN(bitcode::BD, in, m_pDb->unknown53(),         "unknown53");
+template<DWG_VERSION V>
+void OcBsDatabaseHeaderVars::ReadFields(OcBsStreamIn & in, OcDbDatabasePrivate * pDb) const
+{
+    VLOG_FUNC_NAME;
+    const std::vector<uint16_t> & plan = fieldPlans.byVersion[V];
+    uint64_t prevValue = 0;
+
+    for(size_t n = 0; n < plan.size(); ++n)
+    {
+        const size_t i = plan[n];
+        const Field & field = headerVarFields[i];
+
+        if(field.presentIf != -1 && (int64_t) prevValue != field.presentIf)
+        {
+            continue;
+        }
+
+        if(m_selected.empty() || m_selected[i])
+        {
+#if OC_TRACE_BITSTREAM
+            int64_t bitOffset = in.BitOffset();
+#endif
+
+            if(!m_targets.empty() && m_targets[i].pValue)
+            {
+                prevValue = ReadTarget<V>(in, m_targets[i]);
+            }
+            else
+            {
+                prevValue = field.read[V](in, *pDb);
+            }
+
+#if OC_TRACE_BITSTREAM
+            OcBsTrace::Record(field.name, bitOffset, prevValue);
+#endif
+        }
+        else
+        {
+            prevValue = SkipField<V>(in, field.type);
+        }
     }
+}
 
-    // R14+
-    if(dwgVersion >= R14)
+OcApp::ErrorStatus OcBsDatabaseHeaderVars::ReadDwg(OcBsStreamIn & in, OcDbDatabasePrivate *& m_pDb)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "OcBsDatabaseHearderVars::ReadDwg entered";
+
+    if(!m_pDb && NeedsDatabase())
+    {
+        return OcApp::eNullPointer;
+    }
+
+    bitcode::RC sentinelData[16];
+    in.ReadRC(sentinelData, 16);
+    if(!CompareSentinels(sentinelHeaderVarsStart, sentinelData))
+    {
+        return OcApp::eInvalidHeaderSentinal;
+    }
+
+    const DWG_VERSION dwgVersion = in.Version();
+
+    // per spec, the CRC starts here with an initial value of 0xc0c1
+    auto crcStart = in.FilePosition();
+
+    // spec says this is a R2007 variable only and is the size in "bits",
+    // but that doesn't seem totally correct.
+    // At least for the R2008 drawing down, converted to R14, this value
+    // appears to be the size of the header in "bytes".
+    //   if(dwgVersion == R2007) {
+    //       BS_STREAMIN(bitcode::RL, in, pHdr->size, "Header variables size");
+    int size;
+    BS_STREAMIN(bitcode::RL, in, size, "Header variables size");
+    //   }
+
+    auto startPos = in.FilePosition();
+
+    switch(dwgVersion)
     {
-        BS_STREAMIN(bitcode::BS, in, m_pDb->unknown54(), "unknown54");  // short(type 5 / 6 only)  these do not seem to be required,
-        BS_STREAMIN(bitcode::BS, in, m_pDb->unknown55(), "unknown55");  // short(type 5 / 6 only)  even for type 5.
-        BS_STREAMIN(bitcode::BS, in, m_pDb->unknown56(), "unknown56");  // short(type 5 / 6 only)
-        BS_STREAMIN(bitcode::BS, in, m_pDb->unknown57(), "unknown57");  // short(type 5 / 6 only)
+    case R13:
+        ReadFields<R13>(in, m_pDb);
+        break;
+    case R14:
+        ReadFields<R14>(in, m_pDb);
+        break;
+    case R2000:
+        ReadFields<R2000>(in, m_pDb);
+        break;
+    case R2004:
+        ReadFields<R2004>(in, m_pDb);
+        break;
+    case R2007:
+        ReadFields<R2007>(in, m_pDb);
+        break;
+    case R2010:
+        ReadFields<R2010>(in, m_pDb);
+        break;
+    default:
+        return OcApp::eUnsupportedVersion;
     }
 
     in.AdvanceToByteBoundary();
@@ -683,20 +1085,9 @@ OcApp::ErrorStatus OcBsDatabaseHeaderVars::ReadDwg(OcBsStreamIn & in, OcDbDataba
                    << in.FilePosition();
     }
 
-    uint16_t fileCRC, calcedCRC = in.CalcedCRC();
-    in.ReadCRC(fileCRC); //  >> (bitcode::RS&) crc1;
-
-    if(calcedCRC != fileCRC)
-    {
-        LOG(ERROR) << "file section and calced CRC do not match";
-        LOG(ERROR) << "Header variables CRC = " << hex << showbase << fileCRC;
-        LOG(ERROR) << "Calced CRC          = " << hex << showbase << calcedCRC;
-    }
-    else
-    {
-        VLOG(4) << "CRC for Header variables section = "
-                << hex << showbase << fileCRC;
-    }
+    // checked by CheckCRC
+    m_calcedCRC = in.CalcCRCAsync(crcStart, in.FilePosition());
+    in.ReadCRC(m_fileCRC); //  >> (bitcode::RS&) crc1;
 
     // common
     //    BS_STREAMIN(bitcode::RS, in, pHdr->crc(), "crc"); // for the data section, starting after the
@@ -734,4 +1125,26 @@ OcApp::ErrorStatus OcBsDatabaseHeaderVars::ReadDwg(OcBsStreamIn & in, OcDbDataba
     return OcApp::eNotImplemented;
 }
 
+void OcBsDatabaseHeaderVars::CheckCRC(void)
+{
+    VLOG_FUNC_NAME;
+    if(!m_calcedCRC.valid())
+    {
+        return;
+    }
+
+    uint16_t calcedCRC = m_calcedCRC.get();
+    if(calcedCRC != m_fileCRC)
+    {
+        LOG(ERROR) << "file section and calced CRC do not match";
+        LOG(ERROR) << "Header variables CRC = " << hex << showbase << m_fileCRC;
+        LOG(ERROR) << "Calced CRC          = " << hex << showbase << calcedCRC;
+    }
+    else
+    {
+        VLOG(4) << "CRC for Header variables section = "
+                << hex << showbase << m_fileCRC;
+    }
+}
+
 END_OCTAVARIUM_NS
@@ -44,19 +44,98 @@
 ****************************************************************************/
 
 #pragma once
+#include "OcBsDwgVersion.h"
+
+#include <future>
 
 BEGIN_OCTAVARIUM_NS
 
 class OcBsStreamIn;
 class OcDbDatabasePrivate;
+class OcGePoint3D;
 
 class OcBsDatabaseHeaderVars
 {
 public:
+    /// bitcode a header variable is stored as, H is a handle
+    enum Type { eB, eBS, eBL, eBD, eRC, eRD2, eBD3, eT, eTV, eCMC, eH };
+
+    /**
+     *  One entry of the header variables table, in file order. A
+     *  variable stored differently across versions has an entry per
+     *  version range, all with the same name.
+     */
+    typedef uint64_t (*ReadFn)(OcBsStreamIn & in, OcDbDatabasePrivate & db);
+
+    struct Field
+    {
+        const char * name;          // OcDbDatabasePrivate member
+        Type type;
+        DWG_VERSION firstVersion;
+        DWG_VERSION lastVersion;
+        int presentIf;              // -1, or the previous field's value
+                                    // required for this one to be stored
+        ReadFn read[R2010 + 1];     // by version, decodes the field
+                                    // without testing the version
+    };
+
     OcBsDatabaseHeaderVars(void);
     virtual ~OcBsDatabaseHeaderVars(void);
 
+    static size_t NumFields(void);
+    static const Field & GetField(size_t index);
+
+    /**
+     *  Limits ReadDwg to the named variables, the rest are skipped over
+     *  without being decoded. Returns false if name is not in the table.
+     *  Until the first call every variable is decoded.
+     */
+    bool Select(const std::string & name);
+    void SelectAll(void);
+
+    /**
+     *  Selects the named variable and has ReadDwg decode it into value
+     *  instead of the database, value must outlive ReadDwg. Returns false
+     *  if name is not in the table or is not stored as value's type (BD3,
+     *  BS and BL). When every selected variable has a value ReadDwg needs
+     *  no database.
+     */
+    bool Select(const std::string & name, OcGePoint3D & value);
+    bool Select(const std::string & name, int16_t & value);
+    bool Select(const std::string & name, int32_t & value);
+
     OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in, OcDbDatabasePrivate *& m_pDb);
+
+    /**
+     *  Waits for the section crc ReadDwg started and logs a mismatch,
+     *  which is not treated as an error. Called once the following
+     *  sections are decoded, so the crc pass overlaps with them, and
+     *  before the stream ReadDwg read is closed.
+     */
+    void CheckCRC(void);
+
+private:
+    // where a variable selected with a value is decoded to
+    struct Target
+    {
+        Target() : type(eB), pValue(nullptr) {}
+        Type type;
+        void * pValue;
+    };
+
+    bool SelectInto(const std::string & name, Type type, void * pValue);
+    bool NeedsDatabase(void) const;
+    template<DWG_VERSION V>
+    void ReadFields(OcBsStreamIn & in, OcDbDatabasePrivate * pDb) const;
+    template<DWG_VERSION V>
+    static uint64_t ReadTarget(OcBsStreamIn & in, const Target & target);
+    template<DWG_VERSION V>
+    static uint64_t SkipField(OcBsStreamIn & in, Type type);
+
+    std::future<uint16_t> m_calcedCRC;
+    uint16_t m_fileCRC;
+    std::vector<bool> m_selected;   // by field index, empty for all
+    std::vector<Target> m_targets;  // by field index, empty for none
 };
 
 END_OCTAVARIUM_NS
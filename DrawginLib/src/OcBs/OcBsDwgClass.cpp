@@ -47,7 +47,13 @@
 
 BEGIN_OCTAVARIUM_NS
 
-OcBsDwgClass::OcBsDwgClass(void)
+OcBsDwgClass::OcBsDwgClass(OcDbStringPool & strings)
+    : m_classNumber(0), m_version(0), m_proxyFlags(0),
+      m_pStrings(&strings), m_appName(OcDbStringPool::emptyId),
+      m_dxfClassName(OcDbStringPool::emptyId),
+      m_cppClassName(OcDbStringPool::emptyId),
+      m_bWasAZombie(false), m_itemClassId(0), m_numberOfObjects(0),
+      m_dwgVersion(0), m_maintenanceVersion(0), m_unknown1(0), m_unknown2(0)
 {
     VLOG_FUNC_NAME;
 }
@@ -61,64 +67,117 @@ OcBsDwgClass::~OcBsDwgClass(void)
 OcApp::ErrorStatus OcBsDwgClass::ReadDwg(OcBsStreamIn & in)
 {
     VLOG_FUNC_NAME;
-    VLOG(4) << "OcBsDwgClass::ReadDwg entered";
-    BS_STREAMIN(bitcode::BS, in, ClassNumber(), "class number");
 
-    if(ClassNumber() < 500)
+    switch(in.Version())
     {
-        int y =0;
-        y++;
+    case R13:
+        return ReadDwg<R13>(in);
+    case R14:
+        return ReadDwg<R14>(in);
+    case R2000:
+        return ReadDwg<R2000>(in);
+    case R2004:
+        return ReadDwg<R2004>(in);
+    case R2007:
+        return ReadDwg<R2007>(in);
+    case R2010:
+        return ReadDwg<R2010>(in);
+    default:
+        return OcApp::eUnsupportedVersion;
     }
+}
+
+// The accessors return copies, so fields are read into locals and then
+// stored. Reading through the getters only filled temporaries.
+template<DWG_VERSION V>
+OcApp::ErrorStatus OcBsDwgClass::ReadDwg(OcBsStreamIn & in)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "OcBsDwgClass::ReadDwg entered";
+    int16_t classNumber;
+    BS_STREAMIN(bitcode::BS, in, classNumber, "class number");
+    ClassNumber(classNumber);
 
-    if(in.Version() <= R2004)
+    if(V <= R2004)
     {
-        BS_STREAMIN(bitcode::BS, in, Version(), "version");
+        int16_t version;
+        BS_STREAMIN(bitcode::BS, in, version, "version");
+        Version(version);
     }
 
-    if(in.Version() >= R2007)
+    if(V >= R2007)
     {
-        BS_STREAMIN(bitcode::BS, in, ProxyFlags(), "proxy flags");
+        int16_t proxyFlags;
+        BS_STREAMIN(bitcode::BS, in, proxyFlags, "proxy flags");
+        ProxyFlags(proxyFlags);
     }
 
-    if(in.Version() <= R2004)
+    std::wstring appName, cppClassName, dxfClassName;
+
+    if(V <= R2004)
     {
-        BS_STREAMIN(bitcode::TV, in, AppName(), "app name");
-        BS_STREAMIN(bitcode::TV, in, CppClassName(), "cpp ClassName");
-        BS_STREAMIN(bitcode::TV, in, DxfClassName(), "class DXF name");
+        BS_STREAMIN(bitcode::TV, in, appName, "app name");
+        BS_STREAMIN(bitcode::TV, in, cppClassName, "cpp ClassName");
+        BS_STREAMIN(bitcode::TV, in, dxfClassName, "class DXF name");
     }
     else
     {
-        BS_STREAMIN(bitcode::TU, in, AppName(), "app name");
-        BS_STREAMIN(bitcode::TU, in, CppClassName(), "cpp ClassName");
-        BS_STREAMIN(bitcode::TU, in, DxfClassName(), "class DXF name");
+        BS_STREAMIN(bitcode::TU, in, appName, "app name");
+        BS_STREAMIN(bitcode::TU, in, cppClassName, "cpp ClassName");
+        BS_STREAMIN(bitcode::TU, in, dxfClassName, "class DXF name");
     }
 
-    BS_STREAMIN(bitcode::B,  in, WasAZombie(), "was a zombie");
-    BS_STREAMIN(bitcode::BS, in, ItemClassId(), "item class id");
+    m_appName = m_pStrings->Intern(appName);
+    m_cppClassName = m_pStrings->Intern(cppClassName);
+    m_dxfClassName = m_pStrings->Intern(dxfClassName);
 
-    if(in.Version() >= R2004)
+    uint8_t wasAZombie;
+    int16_t itemClassId;
+    BS_STREAMIN(bitcode::B,  in, wasAZombie, "was a zombie");
+    BS_STREAMIN(bitcode::BS, in, itemClassId, "item class id");
+    WasAZombie(wasAZombie != 0);
+    ItemClassId(itemClassId);
+
+    if(V >= R2004)
     {
-        BS_STREAMIN(bitcode::BL, in, NumberOfObjects(), "number of objects");
+        int32_t numberOfObjects, unknown1, unknown2;
+        BS_STREAMIN(bitcode::BL, in, numberOfObjects, "number of objects");
+        NumberOfObjects(numberOfObjects);
 
-        if(in.Version() == R2004)
+        if(V == R2004)
         {
-            BS_STREAMIN(bitcode::BS, in, DwgVersion(), "dwg version");
-            BS_STREAMIN(bitcode::BS, in, MaintenanceVersion(),
+            int16_t dwgVersion, maintenanceVersion;
+            BS_STREAMIN(bitcode::BS, in, dwgVersion, "dwg version");
+            BS_STREAMIN(bitcode::BS, in, maintenanceVersion,
                         "maintenance version");
+            DwgVersion(dwgVersion);
+            MaintenanceVersion(maintenanceVersion);
         }
         else
         {
-            BS_STREAMIN(bitcode::BL, in, DwgVersion(), "dwg version");
-            BS_STREAMIN(bitcode::BL, in, MaintenanceVersion(),
+            int32_t dwgVersion, maintenanceVersion;
+            BS_STREAMIN(bitcode::BL, in, dwgVersion, "dwg version");
+            BS_STREAMIN(bitcode::BL, in, maintenanceVersion,
                         "maintenance version");
+            DwgVersion(dwgVersion);
+            MaintenanceVersion(maintenanceVersion);
         }
 
-        BS_STREAMIN(bitcode::BL, in, Unknown1(), "unknown1");
-        BS_STREAMIN(bitcode::BL, in, Unknown2(), "unknown2");
+        BS_STREAMIN(bitcode::BL, in, unknown1, "unknown1");
+        BS_STREAMIN(bitcode::BL, in, unknown2, "unknown2");
+        Unknown1(unknown1);
+        Unknown2(unknown2);
     }
 
     VLOG(4) << "Successfully decoded Class";
     return OcApp::eOk;
 }
 
+template OcApp::ErrorStatus OcBsDwgClass::ReadDwg<R13>(OcBsStreamIn & in);
+template OcApp::ErrorStatus OcBsDwgClass::ReadDwg<R14>(OcBsStreamIn & in);
+template OcApp::ErrorStatus OcBsDwgClass::ReadDwg<R2000>(OcBsStreamIn & in);
+template OcApp::ErrorStatus OcBsDwgClass::ReadDwg<R2004>(OcBsStreamIn & in);
+template OcApp::ErrorStatus OcBsDwgClass::ReadDwg<R2007>(OcBsStreamIn & in);
+template OcApp::ErrorStatus OcBsDwgClass::ReadDwg<R2010>(OcBsStreamIn & in);
+
 END_OCTAVARIUM_NS
\ No newline at end of file
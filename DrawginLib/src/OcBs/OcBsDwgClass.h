@@ -46,6 +46,8 @@
 #pragma once
 #include "templates\accessors.h"
 #include "templates\bounded.h"
+#include "..\OcDb\OcDbStringPool.h"
+#include "OcBsDwgVersion.h"
 
 BEGIN_OCTAVARIUM_NS
 
@@ -54,11 +56,16 @@ class OcBsStreamIn;
 class OcBsDwgClass
 {
 public:
-    OcBsDwgClass(void);
+    explicit OcBsDwgClass(OcDbStringPool & strings);
     virtual ~OcBsDwgClass(void);
 
     OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in);
 
+    /// ReadDwg for a stream known to hold a version V drawing, instantiated
+    /// for R13 - R2010.
+    template<DWG_VERSION V>
+    OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in);
+
     /*-------------------- Common --------------------*/
 
     /**
@@ -127,11 +134,11 @@ public:
     //accessors<std::wstring> AppName;
     const std::wstring & AppName() const
     {
-        return m_appName;
+        return m_pStrings->String(m_appName);
     }
-    void AppName(const std::wstring & val)
+    OcDbStringPool::Id AppNameId() const
     {
-        m_appName = val;
+        return m_appName;
     }
 
     /**
@@ -144,11 +151,11 @@ public:
     //accessors<std::wstring> DxfClassName;
     const std::wstring & DxfClassName() const
     {
-        return m_dxfClassName;
+        return m_pStrings->String(m_dxfClassName);
     }
-    void DxfClassName(const std::wstring & val)
+    OcDbStringPool::Id DxfClassNameId() const
     {
-        m_dxfClassName = val;
+        return m_dxfClassName;
     }
 
     /**
@@ -158,11 +165,11 @@ public:
     //accessors<std::wstring> CppClassName;
     const std::wstring & CppClassName() const
     {
-        return m_cppClassName;
+        return m_pStrings->String(m_cppClassName);
     }
-    void CppClassName(const std::wstring & val)
+    OcDbStringPool::Id CppClassNameId() const
     {
-        m_cppClassName = val;
+        return m_cppClassName;
     }
 
     /**
@@ -282,11 +289,14 @@ private:
 
     int16_t m_proxyFlags;
 
-    std::wstring m_appName;
+    // the names are ids in m_pStrings, the database's string pool
+    OcDbStringPool * m_pStrings;
+
+    OcDbStringPool::Id m_appName;
 
-    std::wstring m_dxfClassName;
+    OcDbStringPool::Id m_dxfClassName;
 
-    std::wstring m_cppClassName;
+    OcDbStringPool::Id m_cppClassName;
 
     bool m_bWasAZombie;
 
@@ -51,6 +51,7 @@ BEGIN_OCTAVARIUM_NS
 using namespace std;
 
 OcBsDwgClasses::OcBsDwgClasses(void)
+    : m_sectionCRC(0), m_pStrings(nullptr)
 {
     VLOG_FUNC_NAME;
 }
@@ -67,20 +68,115 @@ const OcBsDwgClass & OcBsDwgClasses::ClassAt(size_t index) const
     return m_classes.at(index);
 }
 
+size_t OcBsDwgClasses::NumClasses() const
+{
+    VLOG_FUNC_NAME;
+    return m_classes.size();
+}
+
+const OcBsDwgClass * OcBsDwgClasses::Find(int classNumber) const
+{
+    VLOG_FUNC_NAME;
+    size_t slot = (size_t)(classNumber - 500);
+
+    if(classNumber < 500 || slot >= m_byNumber.size() || m_byNumber[slot] < 0)
+    {
+        return nullptr;
+    }
+
+    return &m_classes[m_byNumber[slot]];
+}
+
+const OcBsDwgClass * OcBsDwgClasses::FindByCppName(const std::wstring & cppClassName) const
+{
+    VLOG_FUNC_NAME;
+    return FindByName(m_byCppName, cppClassName);
+}
+
+const OcBsDwgClass * OcBsDwgClasses::FindByDxfName(const std::wstring & dxfClassName) const
+{
+    VLOG_FUNC_NAME;
+    return FindByName(m_byDxfName, dxfClassName);
+}
+
 bool OcBsDwgClasses::Has(const std::wstring & className) const
 {
     VLOG_FUNC_NAME;
-    return m_classes.end() != std::find_if(m_classes.begin(), m_classes.end(),
-                                           [&](const OcBsDwgClass & c)
+    return FindByCppName(className) != nullptr;
+}
+
+const OcBsDwgClass * OcBsDwgClasses::FindByName(const std::unordered_map<OcDbStringPool::Id, size_t> & byName,
+                                                const std::wstring & name) const
+{
+    VLOG_FUNC_NAME;
+
+    // a name that was never interned can't belong to any class
+    OcDbStringPool::Id id = m_pStrings ? m_pStrings->Find(name) : OcDbStringPool::npos;
+    auto it = byName.find(id);
+    return it != byName.end() ? &m_classes[it->second] : nullptr;
+}
+
+void OcBsDwgClasses::BuildRegistry()
+{
+    VLOG_FUNC_NAME;
+    m_byNumber.clear();
+    m_byCppName.clear();
+    m_byDxfName.clear();
+
+    for(size_t i = 0; i < m_classes.size(); ++i)
     {
-        return c.CppClassName() == className;
-    });
+        const OcBsDwgClass & cls = m_classes[i];
+
+        if(cls.ClassNumber() < 500)
+        {
+            LOG(WARNING) << "Class number " << cls.ClassNumber()
+                         << " is below 500, objects can't refer to it";
+        }
+        else
+        {
+            size_t slot = (size_t)(cls.ClassNumber() - 500);
+
+            if(slot >= m_byNumber.size())
+            {
+                m_byNumber.resize(slot + 1, -1);
+            }
+
+            if(m_byNumber[slot] < 0)
+            {
+                m_byNumber[slot] = (int32_t) i;
+            }
+            else
+            {
+                LOG(WARNING) << "Duplicate class number " << cls.ClassNumber();
+            }
+        }
+
+        // the first class wins when names repeat
+        m_byCppName.insert(std::make_pair(cls.CppClassNameId(), i));
+        m_byDxfName.insert(std::make_pair(cls.DxfClassNameId(), i));
+    }
 }
 
-OcApp::ErrorStatus OcBsDwgClasses::ReadDwg(OcBsStreamIn & in)
+template<DWG_VERSION V>
+void OcBsDwgClasses::ReadClasses(OcBsStreamIn & in, OcDbStringPool & strings,
+                                 std::streamoff endSection)
+{
+    VLOG_FUNC_NAME;
+
+    while(in.FilePosition() < endSection)
+    {
+        OcBsDwgClass cls(strings);
+        cls.ReadDwg<V>(in);
+        //in >> cls;
+        m_classes.push_back(cls);
+    }
+}
+
+OcApp::ErrorStatus OcBsDwgClasses::ReadDwg(OcBsStreamIn & in, OcDbStringPool & strings)
 {
     VLOG_FUNC_NAME;
     VLOG(4) << "OcBsDwgClasses::ReadDwg entered";
+    m_pStrings = &strings;
     bitcode::RC sentinelData[16];
     in.ReadRC(sentinelData, 16);
     if(!CompareSentinels(sentinelClassesSectionStart, sentinelData))
@@ -88,7 +184,8 @@ OcApp::ErrorStatus OcBsDwgClasses::ReadDwg(OcBsStreamIn & in)
         return OcApp::eInvalidClassesDataSentinel;
     }
 
-    in.SetCalcedCRC(0xc0c1);
+    // crc covers everything from the section size up to the section crc
+    auto crcStart = in.FilePosition();
     int size;
     BS_STREAMIN(bitcode::RL, in, size, "classes section size");
     auto endSection = in.FilePosition() + size - 1;
@@ -108,14 +205,33 @@ OcApp::ErrorStatus OcBsDwgClasses::ReadDwg(OcBsStreamIn & in)
         // B : bool value (true if string stream is present)
     }
 
-    while(in.FilePosition() < endSection)
+    // pick the version once, not for every field of every class
+    switch(in.Version())
     {
-        OcBsDwgClass cls;
-        cls.ReadDwg(in);
-        //in >> cls;
-        m_classes.push_back(cls);
+    case R13:
+        ReadClasses<R13>(in, strings, endSection);
+        break;
+    case R14:
+        ReadClasses<R14>(in, strings, endSection);
+        break;
+    case R2000:
+        ReadClasses<R2000>(in, strings, endSection);
+        break;
+    case R2004:
+        ReadClasses<R2004>(in, strings, endSection);
+        break;
+    case R2007:
+        ReadClasses<R2007>(in, strings, endSection);
+        break;
+    case R2010:
+        ReadClasses<R2010>(in, strings, endSection);
+        break;
+    default:
+        return OcApp::eUnsupportedVersion;
     }
 
+    BuildRegistry();
+
     if(in.FilePosition() != endSection)
     {
         LOG(ERROR) << "File position should be "
@@ -123,21 +239,10 @@ OcApp::ErrorStatus OcBsDwgClasses::ReadDwg(OcBsStreamIn & in)
                    << in.FilePosition();
     }
 
-    // Check and log CRC
-    uint16_t calcedCRC = in.CalcedCRC();
-    uint16_t sectionCRC;
-    in.ReadCRC(sectionCRC);
-
-    if(calcedCRC != sectionCRC)
-    {
-        LOG(ERROR) << "file section and calced CRC's do not match";
-        LOG(ERROR) << "Classes section CRC = " << hex << showbase << sectionCRC;
-        LOG(ERROR) << "Calced CRC          = " << hex << showbase << calcedCRC;
-    }
-    else
-    {
-        VLOG(4) << "CRC for Classes Section = " << hex << showbase << sectionCRC;
-    }
+    // CRC is checked and logged by CheckCRC
+    in.AdvanceToByteBoundary();
+    m_calcedCRC = in.CalcCRCAsync(crcStart, in.FilePosition());
+    in.ReadCRC(m_sectionCRC);
 
     // match classes section end sentinel
     in.ReadRC(sentinelData, 16);
@@ -151,4 +256,25 @@ OcApp::ErrorStatus OcBsDwgClasses::ReadDwg(OcBsStreamIn & in)
     return OcApp::eOk;
 }
 
+void OcBsDwgClasses::CheckCRC(void)
+{
+    VLOG_FUNC_NAME;
+    if(!m_calcedCRC.valid())
+    {
+        return;
+    }
+
+    uint16_t calcedCRC = m_calcedCRC.get();
+    if(calcedCRC != m_sectionCRC)
+    {
+        LOG(ERROR) << "file section and calced CRC's do not match";
+        LOG(ERROR) << "Classes section CRC = " << hex << showbase << m_sectionCRC;
+        LOG(ERROR) << "Calced CRC          = " << hex << showbase << calcedCRC;
+    }
+    else
+    {
+        VLOG(4) << "CRC for Classes Section = " << hex << showbase << m_sectionCRC;
+    }
+}
+
 END_OCTAVARIUM_NS
\ No newline at end of file
@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <future>
+#include <unordered_map>
 #include "OcBsDwgClass.h"
 
 BEGIN_OCTAVARIUM_NS
@@ -56,12 +58,45 @@ public:
     virtual ~OcBsDwgClasses(void);
 
     const OcBsDwgClass & ClassAt(size_t index) const;
+    size_t NumClasses() const;
+
+    /**
+     *  Returns the class an object type >= 500 refers to, or nullptr when
+     *  the drawing has no class with that number. Class numbers do not
+     *  have to be contiguous.
+     */
+    const OcBsDwgClass * Find(int classNumber) const;
+    const OcBsDwgClass * FindByCppName(const std::wstring & cppClassName) const;
+    const OcBsDwgClass * FindByDxfName(const std::wstring & dxfClassName) const;
     bool Has(const std::wstring & className) const;
 
-    OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in);
+    OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in, OcDbStringPool & strings);
+
+    /**
+     *  Waits for the section crc ReadDwg started and logs a mismatch,
+     *  which is not treated as an error. Must be called before the
+     *  stream ReadDwg read is closed.
+     */
+    void CheckCRC(void);
 
 private:
+    template<DWG_VERSION V>
+    void ReadClasses(OcBsStreamIn & in, OcDbStringPool & strings,
+                     std::streamoff endSection);
+    void BuildRegistry();
+    const OcBsDwgClass * FindByName(const std::unordered_map<OcDbStringPool::Id, size_t> & byName,
+                                    const std::wstring & name) const;
+
     std::vector<OcBsDwgClass> m_classes;
+    std::future<uint16_t> m_calcedCRC;
+    uint16_t m_sectionCRC;
+    OcDbStringPool * m_pStrings;
+
+    // index into m_classes by class number - 500, -1 for unused numbers
+    std::vector<int32_t> m_byNumber;
+    // index into m_classes by interned name
+    std::unordered_map<OcDbStringPool::Id, size_t> m_byCppName;
+    std::unordered_map<OcDbStringPool::Id, size_t> m_byDxfName;
 };
 
 END_OCTAVARIUM_NS
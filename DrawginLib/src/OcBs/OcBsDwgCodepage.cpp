@@ -0,0 +1,481 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include "OcCommon.h"
+#include <map>
+#include <mutex>
+#include <set>
+#include <wchar.h>
+#include "OcError.h"
+#include "OcBsDwgCodepage.h"
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <errno.h>
+#   include <iconv.h>
+#endif
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#  include <emmintrin.h>
+#  define OC_WIDEN_SSE2 1
+#else
+#  define OC_WIDEN_SSE2 0
+#endif
+
+BEGIN_OCTAVARIUM_NS
+
+namespace
+{
+const size_t npos = (size_t) -1;
+
+// The platform's names for each DWG codepage number, the Windows
+// codepage and the iconv encoding. C libraries don't agree on iconv
+// names, the alias is tried when the first name is not known. A Windows
+// codepage of 0 marks text that is stored as is.
+struct SystemCodePage
+{
+    int windows;
+    const char * iconvName;
+    const char * iconvAlias;
+};
+
+const SystemCodePage systemCodePages[] =
+{
+    { 0,     nullptr,       nullptr },              // undefined
+    { 0,     nullptr,       nullptr },              // US_ASCII
+    { 0,     nullptr,       nullptr },              // ISO_8859_1
+    { 28592, "ISO-8859-2",  nullptr },              // ISO_8859_2
+    { 28593, "ISO-8859-3",  nullptr },              // ISO_8859_3
+    { 28594, "ISO-8859-4",  nullptr },              // ISO_8859_4
+    { 28595, "ISO-8859-5",  nullptr },              // ISO_8859_5
+    { 28596, "ISO-8859-6",  nullptr },              // ISO_8859_6
+    { 28597, "ISO-8859-7",  nullptr },              // ISO_8859_7
+    { 28598, "ISO-8859-8",  nullptr },              // ISO_8859_8
+    { 28599, "ISO-8859-9",  nullptr },              // ISO_8859_9
+    { 437,   "CP437",       "IBM437" },             // CP437
+    { 850,   "CP850",       "IBM850" },             // CP850
+    { 852,   "CP852",       "IBM852" },             // CP852
+    { 855,   "CP855",       "IBM855" },             // CP855
+    { 857,   "CP857",       "IBM857" },             // CP857
+    { 860,   "CP860",       "IBM860" },             // CP860
+    { 861,   "CP861",       "IBM861" },             // CP861
+    { 863,   "CP863",       "IBM863" },             // CP863
+    { 864,   "CP864",       "IBM864" },             // CP864
+    { 865,   "CP865",       "IBM865" },             // CP865
+    { 869,   "CP869",       "IBM869" },             // CP869
+    { 932,   "CP932",       "SHIFT_JIS" },          // CP932
+    { 10000, "MACINTOSH",   "MAC" },                // MACINTOSH
+    { 950,   "CP950",       "BIG5" },               // BIG5
+    { 949,   "CP949",       "EUC-KR" },             // CP949
+    { 1361,  "JOHAB",       nullptr },              // JOHAB
+    { 866,   "CP866",       "IBM866" },             // CP866
+    { 1250,  "CP1250",      "WINDOWS-1250" },       // ANSI_1250
+    { 1251,  "CP1251",      "WINDOWS-1251" },       // ANSI_1251
+    { 1252,  "CP1252",      "WINDOWS-1252" },       // ANSI_1252
+    { 936,   "CP936",       "GBK" },                // GB2312
+    { 1253,  "CP1253",      "WINDOWS-1253" },       // ANSI_1253
+    { 1254,  "CP1254",      "WINDOWS-1254" },       // ANSI_1254
+    { 1255,  "CP1255",      "WINDOWS-1255" },       // ANSI_1255
+    { 1256,  "CP1256",      "WINDOWS-1256" },       // ANSI_1256
+    { 1257,  "CP1257",      "WINDOWS-1257" },       // ANSI_1257
+    { 874,   "CP874",       "WINDOWS-874" },        // ANSI_874
+    { 932,   "CP932",       "SHIFT_JIS" },          // ANSI_932
+    { 936,   "CP936",       "GBK" },                // ANSI_936
+    { 949,   "CP949",       "EUC-KR" },             // ANSI_949
+    { 950,   "CP950",       "BIG5" },               // ANSI_950
+    { 1361,  "JOHAB",       nullptr },              // ANSI_1361
+    { 0,     nullptr,       nullptr },              // ANSI_1200, UTF-16 is not used for T strings
+    { 1258,  "CP1258",      "WINDOWS-1258" },       // ANSI_1258
+};
+
+const int numDwgCodePages = sizeof(systemCodePages) / sizeof(systemCodePages[0]);
+
+// Built converters by system codepage, nullptr for the ones that could
+// not be built. Never freed, they are shared by every stream.
+std::mutex codepageMutex;
+std::map<int, std::unique_ptr<OcBsDwgCodepage> > codepages;
+// unknown DWG codepage numbers already warned about, under codepageMutex
+std::set<int16_t> unknownCodePages;
+
+// One or two bytes to a single UTF-16 code unit through the platform's
+// converter. ToWide returns 1 on success, -1 when the byte starts a
+// double byte character and 0 when the bytes are not a character.
+#ifdef _WIN32
+class SystemConverter
+{
+    DISABLE_COPY(SystemConverter);
+public:
+    SystemConverter(const SystemCodePage & codePage) : m_codePage(codePage.windows) {}
+
+    bool IsOpen() const
+    {
+        return ::IsValidCodePage(m_codePage) != 0;
+    }
+
+    int ToWide(const uint8_t * p, int n, uint16_t & ch)
+    {
+        if(n == 1 && ::IsDBCSLeadByteEx(m_codePage, p[0]))
+        {
+            return -1;
+        }
+
+        wchar_t out[2];
+
+        if(::MultiByteToWideChar(m_codePage, MB_ERR_INVALID_CHARS,
+                                 (LPCSTR) p, n, out, 2) != 1)
+        {
+            return 0;
+        }
+
+        ch = (uint16_t) out[0];
+        return 1;
+    }
+
+private:
+    int m_codePage;
+};
+#else
+class SystemConverter
+{
+    DISABLE_COPY(SystemConverter);
+public:
+    SystemConverter(const SystemCodePage & codePage)
+    {
+        m_cd = iconv_open("UTF-16LE", codePage.iconvName);
+
+        if(!IsOpen() && codePage.iconvAlias)
+        {
+            m_cd = iconv_open("UTF-16LE", codePage.iconvAlias);
+        }
+    }
+
+    ~SystemConverter()
+    {
+        if(IsOpen())
+        {
+            iconv_close(m_cd);
+        }
+    }
+
+    bool IsOpen() const
+    {
+        return m_cd != (iconv_t) -1;
+    }
+
+    int ToWide(const uint8_t * p, int n, uint16_t & ch)
+    {
+        char in[2] = { (char) p[0], n > 1 ? (char) p[1] : '\0' };
+        uint8_t out[8];
+        char * pIn = in;
+        char * pOut = (char *) out;
+        size_t inLeft = n;
+        size_t outLeft = sizeof(out);
+
+        iconv(m_cd, nullptr, nullptr, nullptr, nullptr);
+
+        if(iconv(m_cd, &pIn, &inLeft, &pOut, &outLeft) == (size_t) -1)
+        {
+            return errno == EINVAL ? -1 : 0;
+        }
+
+        // some converters (CP1258) hold a character back waiting for a
+        // combining mark, flush it out
+        iconv(m_cd, nullptr, nullptr, &pOut, &outLeft);
+
+        if(sizeof(out) - outLeft != 2)
+        {
+            return 0;
+        }
+
+        ch = (uint16_t)(out[0] | (out[1] << 8));
+        return 1;
+    }
+
+private:
+    iconv_t m_cd;
+};
+#endif
+
+// Widens whole 16 byte blocks from the start of pSrc. With asciiOnly it
+// stops at the first block holding a byte >= 0x80. Returns the number of
+// bytes widened, and sets firstNul to the index of the first 0 byte if
+// there is one and firstNul is still npos.
+size_t WidenBlocks(wchar_t * pDst, const uint8_t * pSrc, size_t n,
+                   bool asciiOnly, size_t & firstNul)
+{
+    size_t i = 0;
+
+#if OC_WIDEN_SSE2
+    const __m128i zero = _mm_setzero_si128();
+
+    for(; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(pSrc + i));
+
+        if(asciiOnly && _mm_movemask_epi8(v))
+        {
+            break;
+        }
+
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+#  if WCHAR_MAX > 0xffff
+        // 32 bit wchar_t, widen each half once more
+        _mm_storeu_si128((__m128i *)(pDst + i), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i *)(pDst + i + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i *)(pDst + i + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i *)(pDst + i + 12), _mm_unpackhi_epi16(hi, zero));
+#  else
+        _mm_storeu_si128((__m128i *)(pDst + i), lo);
+        _mm_storeu_si128((__m128i *)(pDst + i + 8), hi);
+#  endif
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+
+        if(mask && firstNul == npos)
+        {
+            size_t j = i;
+
+            for(; !(mask & 1); mask >>= 1)
+            {
+                ++j;
+            }
+
+            firstNul = j;
+        }
+    }
+#else
+    (void) pDst;
+    (void) pSrc;
+    (void) n;
+    (void) asciiOnly;
+    (void) firstNul;
+#endif
+
+    return i;
+}
+}
+
+OcBsDwgCodepage::OcBsDwgCodepage(void)
+    : m_asciiIdentity(true)
+{
+    VLOG_FUNC_NAME;
+}
+
+const OcBsDwgCodepage * OcBsDwgCodepage::Get(int16_t dwgCodePage)
+{
+    VLOG_FUNC_NAME;
+
+    if(dwgCodePage < 0 || dwgCodePage >= numDwgCodePages)
+    {
+        std::lock_guard<std::mutex> lock(codepageMutex);
+
+        if(unknownCodePages.insert(dwgCodePage).second)
+        {
+            LOG(WARNING) << "Unknown drawing codepage " << dwgCodePage
+                         << ", text is not converted";
+        }
+
+        return nullptr;
+    }
+
+    const SystemCodePage & systemCodePage = systemCodePages[dwgCodePage];
+
+    if(systemCodePage.windows == 0)
+    {
+        return nullptr;
+    }
+
+    // the converter, or its failure to build, is kept for the process,
+    // so a missing codepage is only reported once
+    std::lock_guard<std::mutex> lock(codepageMutex);
+    auto it = codepages.find(systemCodePage.windows);
+
+    if(it == codepages.end())
+    {
+        std::unique_ptr<OcBsDwgCodepage> pCodepage(new OcBsDwgCodepage);
+
+        if(!pCodepage->Build(dwgCodePage))
+        {
+            LOG(ERROR) << "Codepage " << systemCodePage.windows << " ("
+                       << systemCodePage.iconvName
+                       << ") is not available, text is not converted";
+            pCodepage.reset();
+        }
+
+        it = codepages.insert(std::make_pair(systemCodePage.windows,
+                                             std::move(pCodepage))).first;
+    }
+
+    return it->second.get();
+}
+
+size_t OcBsDwgCodepage::Widen(wchar_t * pDst, const uint8_t * pSrc, size_t n)
+{
+    VLOG_FUNC_NAME;
+    size_t nul = npos;
+    size_t i = WidenBlocks(pDst, pSrc, n, false, nul);
+
+    for(; i < n; ++i)
+    {
+        pDst[i] = pSrc[i];
+
+        if(pSrc[i] == 0 && nul == npos)
+        {
+            nul = i;
+        }
+    }
+
+    return nul == npos ? n : nul;
+}
+
+size_t OcBsDwgCodepage::Decode(wchar_t * pDst, const uint8_t * pSrc, size_t n,
+                               size_t & nul) const
+{
+    VLOG_FUNC_NAME;
+    size_t i = 0;
+    size_t o = 0;
+    nul = npos;
+
+    while(i < n)
+    {
+        uint8_t c = pSrc[i];
+
+        if(c < 0x80 && m_asciiIdentity)
+        {
+            size_t runNul = npos;
+            size_t run = WidenBlocks(pDst + o, pSrc + i, n - i, true, runNul);
+
+            if(runNul != npos && nul == npos)
+            {
+                nul = o + runNul;
+            }
+
+            i += run;
+            o += run;
+
+            if(run)
+            {
+                continue;
+            }
+        }
+
+        uint16_t ch = m_single[c];
+        int row = m_leadRow[c];
+
+        if(row >= 0 && i + 1 < n && m_trail[row * 256 + pSrc[i + 1]] != 0xfffd)
+        {
+            ch = m_trail[row * 256 + pSrc[i + 1]];
+            i += 2;
+        }
+        else
+        {
+            i++;
+        }
+
+        if(ch == 0 && nul == npos)
+        {
+            nul = o;
+        }
+
+        pDst[o++] = ch;
+    }
+
+    if(nul == npos)
+    {
+        nul = n;
+    }
+
+    return o;
+}
+
+bool OcBsDwgCodepage::Build(int16_t dwgCodePage)
+{
+    VLOG_FUNC_NAME;
+    SystemConverter converter(systemCodePages[dwgCodePage]);
+
+    if(!converter.IsOpen())
+    {
+        return false;
+    }
+
+    m_trail.clear();
+    m_asciiIdentity = true;
+
+    for(int c = 0; c < 256; ++c)
+    {
+        uint8_t bytes[2] = { (uint8_t) c, 0 };
+        uint16_t ch = 0xfffd;
+        int result = converter.ToWide(bytes, 1, ch);
+        m_single[c] = result > 0 ? ch : 0xfffd;
+        m_leadRow[c] = -1;
+
+        if(result < 0)
+        {
+            m_leadRow[c] = (int16_t)(m_trail.size() / 256);
+            m_trail.resize(m_trail.size() + 256, 0xfffd);
+            uint16_t * pRow = &m_trail[m_trail.size() - 256];
+
+            for(int trail = 0; trail < 256; ++trail)
+            {
+                bytes[1] = (uint8_t) trail;
+                ch = 0xfffd;
+
+                if(converter.ToWide(bytes, 2, ch) > 0)
+                {
+                    pRow[trail] = ch;
+                }
+            }
+        }
+
+        if(c < 0x80 && m_single[c] != c)
+        {
+            m_asciiIdentity = false;
+        }
+    }
+
+    return true;
+}
+
+END_OCTAVARIUM_NS
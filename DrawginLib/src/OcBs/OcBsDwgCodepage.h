@@ -0,0 +1,98 @@
+/**
+ *	@file
+ *  @brief Defines OcBsDwgCodepage class
+ *
+ *  Converts text stored in a drawing's codepage to wchar_t
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+BEGIN_OCTAVARIUM_NS
+
+/**
+ *  Lookup table converter for the codepage stored in the drawing file
+ *  header (3.2.4). Pre R2007 drawings store T strings in that codepage.
+ *  A codepage's tables are built the first time it is used, from the
+ *  platform's converter, and shared by every stream after that.
+ */
+class OcBsDwgCodepage
+{
+    DISABLE_COPY(OcBsDwgCodepage);
+public:
+    /**
+     *  Returns the converter for a DWG codepage number, or nullptr when
+     *  the text needs no conversion (ASCII, ISO 8859-1) or the codepage is
+     *  not available on this system.
+     */
+    static const OcBsDwgCodepage * Get(int16_t dwgCodePage);
+
+    /**
+     *  Zero extends n bytes to wchar_t, for text that needs no conversion.
+     *  Returns the index of the first NUL, or n when there is none.
+     */
+    static size_t Widen(wchar_t * pDst, const uint8_t * pSrc, size_t n);
+
+    /**
+     *  Converts n bytes, pDst must have room for n characters. Returns the
+     *  number of characters written, double byte characters make it less
+     *  than n. nul is set to the index of the first NUL written, or n when
+     *  there is none.
+     */
+    size_t Decode(wchar_t * pDst, const uint8_t * pSrc, size_t n, size_t & nul) const;
+
+private:
+    OcBsDwgCodepage(void);
+    bool Build(int16_t dwgCodePage);
+
+    // character for each single byte, lead bytes of double byte
+    // characters map to 0xfffd
+    uint16_t m_single[256];
+    // row of m_trail holding a lead byte's characters, -1 if not a lead byte
+    int16_t m_leadRow[256];
+    // 256 entries per lead byte, indexed by the trail byte. 0xfffd when
+    // the pair is not a character.
+    std::vector<uint16_t> m_trail;
+    // 0x00 - 0x7f map to themselves, so ASCII runs can be widened
+    bool m_asciiIdentity;
+};
+
+END_OCTAVARIUM_NS
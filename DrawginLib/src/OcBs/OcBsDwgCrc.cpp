@@ -99,4 +99,52 @@ uint16_t crc8(uint16_t dx, const char * p, long n)
     return dx;
 }
 
+// crcslices[k][i] is the crc of byte i followed by k zero bytes. With
+// them crc8Span folds 8 input bytes into the running crc per iteration.
+struct CrcSlices
+{
+    uint16_t table[8][256];
+
+    CrcSlices()
+    {
+        for(int i = 0; i < 256; ++i)
+        {
+            table[0][i] = crctable[i];
+        }
+
+        for(int k = 1; k < 8; ++k)
+        {
+            for(int i = 0; i < 256; ++i)
+            {
+                uint16_t prev = table[k - 1][i];
+                table[k][i] = (prev >> 8) ^ crctable[prev & 0xff];
+            }
+        }
+    }
+};
+
+static const CrcSlices crcslices;
+
+uint16_t crc8Span(uint16_t dx, const byte_t * p, size_t n)
+{
+    const uint16_t (*t)[256] = crcslices.table;
+
+    while(n >= 8)
+    {
+        uint16_t lo = dx ^ (uint16_t)(p[0] | (p[1] << 8));
+        dx = t[7][lo & 0xff] ^ t[6][lo >> 8] ^
+             t[5][p[2]] ^ t[4][p[3]] ^ t[3][p[4]] ^
+             t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        p += 8;
+        n -= 8;
+    }
+
+    while(n-- > 0)
+    {
+        dx = (dx >> 8) ^ crctable[(dx ^ *p++) & 0xff];
+    }
+
+    return dx;
+}
+
 END_OCTAVARIUM_NS
@@ -49,6 +49,12 @@
 BEGIN_OCTAVARIUM_NS
 uint16_t crc8(uint16_t dx, const char * p, long n);
 
+/**
+ *  Same result as crc8, but processes the span 8 bytes at a time
+ *  (slicing-by-8). Preferred for anything longer than a few bytes.
+ */
+uint16_t crc8Span(uint16_t dx, const byte_t * p, size_t n);
+
 END_OCTAVARIUM_NS
 
 #endif // OcBsDwgCrc_h__
@@ -118,6 +118,18 @@ octavarium::DWG_VERSION OcBsDwgFileHeader::DwgVersion(void) const
     return m_dwgVersion;
 }
 
+int8_t OcBsDwgFileHeader::MaintenanceVersion(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_acadMaintVer;
+}
+
+int16_t OcBsDwgFileHeader::CodePage(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_codePage;
+}
+
 bool OcBsDwgFileHeader::IsPreR13c3(void) const
 {
     VLOG_FUNC_NAME;
@@ -165,7 +177,8 @@ OcApp::ErrorStatus OcBsDwgFileHeader::DecodeR13_R2000Header(OcBsStreamIn & in)
     VLOG(4) << "*** Begin reading file header ***";
 
     std::string sVersion = OcBsDwgVersion::GetVersionId(m_dwgVersion);
-    in.SetCalcedCRC(crc8(0, sVersion.c_str(), 6));
+    uint16_t versionCrc = crc8(0, sVersion.c_str(), 6);
+    auto crcStart = in.FilePosition();
     VLOG(4) << "File ID = " << sVersion;
 
     // more version ID, 3.2.1
@@ -182,6 +195,7 @@ OcApp::ErrorStatus OcBsDwgFileHeader::DecodeR13_R2000Header(OcBsStreamIn & in)
 
     // dwg codepage, 3.2.4
     BS_STREAMIN(RS, in, m_codePage, "codepage");
+    in.SetCodePage(m_codePage);
 
     // section loader records, 3.2.5
     BS_STREAMIN(RL, in, m_nSections, "Selection Locator Records");
@@ -197,7 +211,7 @@ OcApp::ErrorStatus OcBsDwgFileHeader::DecodeR13_R2000Header(OcBsStreamIn & in)
         m_headerSections.push_back(section);
     }
 
-    uint16_t runningCrc = in.CalcedCRC();
+    uint16_t runningCrc = in.CalcCRC(crcStart, in.FilePosition(), versionCrc);
     int16_t headerCrc;
     in >> (RS&) headerCrc;
     uint16_t crcCheck = runningCrc ^ headerCrc;
@@ -67,6 +67,8 @@ public:
     OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in);
 
     DWG_VERSION DwgVersion(void) const;
+    int8_t MaintenanceVersion(void) const;
+    int16_t CodePage(void) const;
     bool IsPreR13c3(void) const;
     bool IsR13c3OrHigher(void) const;
 
@@ -45,27 +45,37 @@
 #include "OcBsDwgClasses.h"
 #include "OcBsDwgObjectMap.h"
 #include "OcBsStreamIn.h"
+#include "OcDbObjectId.h"
 #include <iomanip>
+#include <exception>
+#include <thread>
 
 BEGIN_OCTAVARIUM_NS
 using namespace std;
+
+// object map crc's are stored in MSB order
+static inline uint16_t SwapCRC(uint16_t crc)
+{
+    return (uint16_t)((crc >> 8) | (crc << 8));
+}
+
 class SUB_CLASS_ID
 {
 public:
     SUB_CLASS_ID(int _id, const char * pcszSubClassName)
-        : m_id(_id), m_subClassName(pcszSubClassName) {}
+        : m_id(_id), m_pcszSubClassName(pcszSubClassName) {}
     int Id() const
     {
         return m_id;
     }
-    const std::string & SubClassName() const
+    const char * SubClassName() const
     {
-        return m_subClassName;
+        return m_pcszSubClassName;
     }
 private:
     int m_id;
-    //const char * subClassName;
-    const std::string m_subClassName;
+    // string literal, the table is static
+    const char * m_pcszSubClassName;
 };
 
 std::array<SUB_CLASS_ID, 82> _subClasses =
@@ -156,7 +166,7 @@ std::array<SUB_CLASS_ID, 82> _subClasses =
 };
 
 OcBsDwgObjectMap::OcBsDwgObjectMap(int32_t objMapFilePos, int32_t objMapSize)
-    : m_objMapFilePos(objMapFilePos), m_objMapSize(objMapSize)
+    : m_objMapFilePos(objMapFilePos), m_objMapSize(objMapSize), m_indexBase(0)
 {
     VLOG_FUNC_NAME;
 }
@@ -197,10 +207,11 @@ OcApp::ErrorStatus OcBsDwgObjectMap::ReadDwg(OcBsStreamIn & in)
 
     // section size and crc are values stored in big endian format
     // on disk.
+    std::streamoff crcStart;
     while(1)
     {
-        // reset calced crc to 0xc0c1 for each section
-        in.SetCalcedCRC(0xc0c1);
+        // each section has its own crc, starting at the section size
+        crcStart = in.FilePosition();
         // read section size and convert to little endian format.
         int16_t sectionSize;
         in >> (bitcode::RC&)sectionSize;
@@ -239,7 +250,7 @@ OcApp::ErrorStatus OcBsDwgObjectMap::ReadDwg(OcBsStreamIn & in)
         }
 
         // calc section crc
-        uint16_t crc, calcedCrc = in.CalcedCRC(true);
+        uint16_t crc, calcedCrc = SwapCRC(in.CalcCRC(crcStart, in.FilePosition()));
         in.ReadCRC(crc);
 
         if(crc != calcedCrc)
@@ -252,7 +263,7 @@ OcApp::ErrorStatus OcBsDwgObjectMap::ReadDwg(OcBsStreamIn & in)
     }
 
     // calc final crc
-    uint16_t crc, calcedCrc = in.CalcedCRC(true);
+    uint16_t crc, calcedCrc = SwapCRC(in.CalcCRC(crcStart, in.FilePosition()));
     in.ReadCRC(crc);
 
     if(crc != calcedCrc)
@@ -261,55 +272,375 @@ OcApp::ErrorStatus OcBsDwgObjectMap::ReadDwg(OcBsStreamIn & in)
         return OcApp::eInvalidCRCInObjectMap;
     }
 
+    BuildIndex();
     VLOG(4) << "Successfully decoded Object map";
     return OcApp::eOk;
 }
 
-OcApp::ErrorStatus OcBsDwgObjectMap::DecodeObjects(OcBsStreamIn & in, const OcBsDwgClasses & classes)
+void OcBsDwgObjectMap::BuildIndex()
 {
-    //std::vector<SUB_CLASS_ID> subClasses(&_subClasses[0],
-    //    &_subClasses[ELEMENTS(_subClasses)]);
-    //BOOST_FOREACH(const MapItem &  item, m_objMapItems)
-for(auto item : m_objMapItems)
+    VLOG_FUNC_NAME;
+    m_denseIndex.clear();
+    m_sortedIndex.clear();
+
+    if(m_objMapItems.empty())
+    {
+        return;
+    }
+
+    auto minmax = std::minmax_element(m_objMapItems.begin(), m_objMapItems.end(),
+                                      [](const MapItem & a, const MapItem & b)
+    {
+        return a.first < b.first;
+    });
+    int64_t range = (int64_t) minmax.second->first - minmax.first->first + 1;
+
+    // Handles are mostly dense and increasing, use a direct table unless
+    // it would be much larger than the map itself.
+    if(range <= 2 * (int64_t) m_objMapItems.size() + 1024)
     {
-        VLOG(4) << "--------------------";
-        in.Seek(item.second);
-        VLOG(4) << "Object Handle = " << item.first;
-        VLOG(4) << "Seeking file position = " << item.second;
+        m_indexBase = minmax.first->first;
+        m_denseIndex.assign((size_t) range, -1);
 
-        if(in.Error() != OcApp::eOk)
+        for(size_t i = 0; i < m_objMapItems.size(); ++i)
         {
-            return in.Error();
+            int32_t & slot = m_denseIndex[(size_t)(m_objMapItems[i].first - m_indexBase)];
+
+            if(slot == -1)
+            {
+                slot = (int32_t) i;
+            }
+        }
+    }
+    else
+    {
+        m_sortedIndex.reserve(m_objMapItems.size());
+
+        for(size_t i = 0; i < m_objMapItems.size(); ++i)
+        {
+            m_sortedIndex.push_back(std::make_pair(m_objMapItems[i].first, (int32_t) i));
         }
 
-        uint32_t objSize = 0;
-        uint16_t objType = 0;
-        BS_STREAMIN(bitcode::MS, in, objSize, "Object size = ");
-        BS_STREAMIN(bitcode::BS, in, objType, "Object type = ");
+        std::stable_sort(m_sortedIndex.begin(), m_sortedIndex.end(),
+                         [](const std::pair<int32_t, int32_t> & a, const std::pair<int32_t, int32_t> & b)
+        {
+            return a.first < b.first;
+        });
+    }
+
+    VLOG(4) << "Object map index: " << (m_denseIndex.empty() ? "sorted" : "direct")
+            << ", " << m_objMapItems.size() << " handles";
+}
+
+int32_t OcBsDwgObjectMap::IndexOf(int64_t handle) const
+{
+    VLOG_FUNC_NAME;
 
-        if(objType > _subClasses.size() - 1 && objType < 500)
+    if(!m_denseIndex.empty())
+    {
+        int64_t slot = handle - m_indexBase;
+
+        if(slot < 0 || slot >= (int64_t) m_denseIndex.size())
         {
-            LOG(ERROR) << "Object type outside of known range";
-            LOG(ERROR) << "Sub type = " << hex << showbase << objType;
-            return OcApp::eOutsideOfClassMapRange;
+            return -1;
         }
-        else
+
+        return m_denseIndex[(size_t) slot];
+    }
+
+    auto it = std::lower_bound(m_sortedIndex.begin(), m_sortedIndex.end(), handle,
+                               [](const std::pair<int32_t, int32_t> & a, int64_t h)
+    {
+        return a.first < h;
+    });
+
+    if(it == m_sortedIndex.end() || it->first != handle)
+    {
+        return -1;
+    }
+
+    return it->second;
+}
+
+bool OcBsDwgObjectMap::Has(const OcDbObjectId & objId) const
+{
+    VLOG_FUNC_NAME;
+    return IndexOf(objId.Handle()) != -1;
+}
+
+OcApp::ErrorStatus OcBsDwgObjectMap::FileOffset(const OcDbObjectId & objId, int32_t & offset) const
+{
+    VLOG_FUNC_NAME;
+    int32_t index = IndexOf(objId.Handle());
+
+    if(index == -1)
+    {
+        return OcApp::eNotFound;
+    }
+
+    offset = m_objMapItems[index].second;
+    return OcApp::eOk;
+}
+
+OcApp::ErrorStatus OcBsDwgObjectMap::DecodeObjects(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                                   int nThreads /*= 0*/)
+{
+    VLOG_FUNC_NAME;
+    m_objects.assign(m_objMapItems.size(), ObjectHeader());
+
+    if(nThreads <= 0)
+    {
+        nThreads = std::max<int>(1, std::thread::hardware_concurrency());
+    }
+
+    // Workers need their own cursor over the file bytes, only possible
+    // when the whole file is in memory. Tiny maps aren't worth a thread.
+    const size_t minPerThread = 1024;
+    nThreads = (int) std::min<size_t>(nThreads, m_objMapItems.size() / minPerThread);
+
+    OcApp::ErrorStatus es = OcApp::eOk;
+    std::vector<int32_t> order = FileOrder();
+
+    if(nThreads <= 1 || in.Data() == nullptr)
+    {
+        es = DecodeObjects(in, classes, order, 0, order.size());
+    }
+    else
+    {
+        es = DecodeObjectsParallel(in, classes, order, nThreads);
+    }
+
+    // how far decoding got before an error depends on the number of
+    // workers, so drop partial results rather than expose that.
+    if(es != OcApp::eOk)
+    {
+        m_objects.clear();
+    }
+
+    return es;
+}
+
+std::vector<int32_t> OcBsDwgObjectMap::FileOffsets() const
+{
+    VLOG_FUNC_NAME;
+    std::vector<int32_t> offsets;
+    offsets.reserve(m_objMapItems.size());
+
+    for(auto & item : m_objMapItems)
+    {
+        offsets.push_back(item.second);
+    }
+
+    std::sort(offsets.begin(), offsets.end());
+    return offsets;
+}
+
+std::vector<int32_t> OcBsDwgObjectMap::FileOrder() const
+{
+    VLOG_FUNC_NAME;
+    std::vector<int32_t> order(m_objMapItems.size());
+
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = (int32_t) i;
+    }
+
+    // stable on equal offsets, so the order doesn't depend on the sort
+    std::sort(order.begin(), order.end(), [&](int32_t lhs, int32_t rhs)
+    {
+        int32_t lhsPos = m_objMapItems[lhs].second;
+        int32_t rhsPos = m_objMapItems[rhs].second;
+        return lhsPos < rhsPos || (lhsPos == rhsPos && lhs < rhs);
+    });
+
+    return order;
+}
+
+OcApp::ErrorStatus OcBsDwgObjectMap::DecodeObjectsParallel(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                                           const std::vector<int32_t> & order,
+                                                           int nThreads)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "Decoding " << m_objMapItems.size() << " objects with "
+            << nThreads << " threads";
+
+    // Contiguous, equal sized slices of the file order, so each worker
+    // sweeps its own region of the file. Each worker stops at its first
+    // error, so the lowest failing slice holds the first error in file
+    // order, same as a serial decode would report.
+    std::vector<OcApp::ErrorStatus> results(nThreads, OcApp::eOk);
+    std::vector<std::exception_ptr> exceptions(nThreads);
+    std::vector<OcBsStream::IoCounters> counters(nThreads);
+    std::vector<std::thread> workers;
+    size_t sliceSize = (order.size() + nThreads - 1) / nThreads;
+
+    for(int i = 0; i < nThreads; ++i)
+    {
+        size_t begin = i * sliceSize;
+        size_t end = std::min(begin + sliceSize, order.size());
+        workers.push_back(std::thread([&, i, begin, end]()
         {
-            if(objType >= 500)
+            try
+            {
+                OcBsStreamIn cursor(in.Data(), (size_t) in.FileLength());
+                cursor.SetVersion(in.Version());
+                cursor.ShareCodePage(in);
+                results[i] = DecodeObjects(cursor, classes, order, begin, end);
+                counters[i] = cursor.Counters();
+            }
+            catch(...)
             {
-                const OcBsDwgClass & className = classes.ClassAt(objType - 500);
-                VLOG(4) << "Class name = " <<
-                        WStringToString(className.CppClassName());
+                // handed back to the calling thread below
+                exceptions[i] = std::current_exception();
             }
-            else
+        }));
+    }
+
+    for(int i = 0; i < nThreads; ++i)
+    {
+        workers[i].join();
+        in.AddCounters(counters[i]);
+    }
+
+    for(int i = 0; i < nThreads; ++i)
+    {
+        if(exceptions[i])
+        {
+            m_objects.clear();
+            std::rethrow_exception(exceptions[i]);
+        }
+
+        if(results[i] != OcApp::eOk)
+        {
+            return results[i];
+        }
+    }
+
+    return OcApp::eOk;
+}
+
+OcApp::ErrorStatus OcBsDwgObjectMap::DecodeObjects(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                                   const std::vector<int32_t> & order,
+                                                   size_t begin, size_t end)
+{
+    VLOG_FUNC_NAME;
+
+    // order[begin, end) are map positions in file offset order, results
+    // still go to the object's own slot, which keeps them in handle order
+    for(size_t k = begin; k < end; ++k)
+    {
+        int32_t i = order[k];
+        OcApp::ErrorStatus es = DecodeObject(in, classes, m_objMapItems[i], m_objects[i]);
+
+        if(es != OcApp::eOk)
+        {
+            // each worker has its own trace, log it from the failing thread
+            OcBsTrace::DumpToLog();
+            return es;
+        }
+    }
+
+    return OcApp::eOk;
+}
+
+OcApp::ErrorStatus OcBsDwgObjectMap::DecodeObject(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                                  const MapItem & item, ObjectHeader & obj)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "--------------------";
+    in.Seek(item.second);
+    VLOG(4) << "Object Handle = " << item.first;
+    VLOG(4) << "Seeking file position = " << item.second;
+
+    if(in.Error() != OcApp::eOk)
+    {
+        return in.Error();
+    }
+
+    uint32_t objSize = 0;
+    uint16_t objType = 0;
+    BS_STREAMIN(bitcode::MS, in, objSize, "Object size = ");
+    BS_STREAMIN(bitcode::BS, in, objType, "Object type = ");
+
+    if(objType > _subClasses.size() - 1 && objType < 500)
+    {
+        LOG(ERROR) << "Object type outside of known range";
+        LOG(ERROR) << "Sub type = " << hex << showbase << objType;
+        return OcApp::eOutsideOfClassMapRange;
+    }
+    else
+    {
+        if(objType >= 500)
+        {
+            const OcBsDwgClass * pClass = classes.Find(objType);
+
+            if(!pClass)
             {
-                SUB_CLASS_ID subClass = _subClasses.at(objType);
-                VLOG(4) << "Sub class name = " << subClass.SubClassName();
+                LOG(ERROR) << "Object type " << objType << " is not a class of the drawing";
+                return OcApp::eOutsideOfClassMapRange;
             }
+
+            VLOG(4) << "Class name = " <<
+                    WStringToString(pClass->CppClassName());
+        }
+        else
+        {
+            const SUB_CLASS_ID & subClass = _subClasses.at(objType);
+            VLOG(4) << "Sub class name = " << subClass.SubClassName();
+        }
+    }
+
+    obj.handle = item.first;
+    obj.size = objSize;
+    obj.type = objType;
+    obj.decoded = true;
+    return OcApp::eOk;
+}
+
+OcApp::ErrorStatus OcBsDwgObjectMap::Object(OcBsStreamIn * pIn, const OcBsDwgClasses & classes,
+                                            const OcDbObjectId & objId, ObjectHeader & obj)
+{
+    VLOG_FUNC_NAME;
+    int32_t index = IndexOf(objId.Handle());
+
+    if(index == -1)
+    {
+        return OcApp::eNotFound;
+    }
+
+    std::lock_guard<std::mutex> lock(m_objectMutex);
+
+    if(m_objects.size() != m_objMapItems.size())
+    {
+        m_objects.assign(m_objMapItems.size(), ObjectHeader());
+    }
+
+    ObjectHeader & cached = m_objects[index];
+
+    if(!cached.decoded)
+    {
+        if(pIn == nullptr)
+        {
+            return OcApp::eNotInDatabase;
+        }
+
+        OcApp::ErrorStatus es = DecodeObject(*pIn, classes, m_objMapItems[index], cached);
+
+        if(es != OcApp::eOk)
+        {
+            OcBsTrace::DumpToLog();
+            return es;
         }
     }
+
+    obj = cached;
     return OcApp::eOk;
+}
 
+const std::vector<OcBsDwgObjectMap::ObjectHeader> & OcBsDwgObjectMap::Objects() const
+{
+    VLOG_FUNC_NAME;
+    return m_objects;
 }
 
 END_OCTAVARIUM_NS
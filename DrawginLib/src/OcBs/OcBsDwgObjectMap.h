@@ -45,26 +45,100 @@
 
 #pragma once
 
+#include <mutex>
+
 BEGIN_OCTAVARIUM_NS
 
 class OcBsStreamIn;
 class OcBsDwgClasses;
+class OcDbObjectId;
 
 class OcBsDwgObjectMap
 {
+    DISABLE_COPY(OcBsDwgObjectMap);
 public:
     OcBsDwgObjectMap(int32_t objMapFilePos, int32_t objMapSize);
     virtual ~OcBsDwgObjectMap(void);
 
     OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in);
-    OcApp::ErrorStatus DecodeObjects(OcBsStreamIn & in, const OcBsDwgClasses & classes);
+
+    /**
+     *  Decodes every object in the map. Objects are visited in file offset
+     *  order, one forward sweep over the file, rather than in handle
+     *  order, which jumps back and forth. When the stream decodes from
+     *  memory the sweep is split across nThreads workers (0 uses one per
+     *  hardware thread), each with its own stream over the same bytes.
+     *  Results are stored in map order, which is ascending handle order,
+     *  and the error returned is that of the first failing object in file
+     *  order regardless of the number of workers. On error Objects() is
+     *  empty.
+     */
+    OcApp::ErrorStatus DecodeObjects(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                     int nThreads = 0);
+
+    struct ObjectHeader
+    {
+        int32_t handle;
+        uint32_t size;
+        uint16_t type;
+        bool decoded;
+        ObjectHeader() : handle(0), size(0), type(0), decoded(false) {}
+    };
+
+    const std::vector<ObjectHeader> & Objects() const;
+
+    /**
+     *  Returns the object objId refers to, decoding it from pIn on first
+     *  access and from the cache after that. pIn may be null if all of the
+     *  objects were already decoded by DecodeObjects. Calls are serialized,
+     *  several threads may ask for objects while pIn is shared by them.
+     */
+    OcApp::ErrorStatus Object(OcBsStreamIn * pIn, const OcBsDwgClasses & classes,
+                              const OcDbObjectId & objId, ObjectHeader & obj);
+
+    /**
+     *  Handle lookups, constant time when the handles in the map are
+     *  reasonably dense (the usual case), otherwise a binary search.
+     */
+    bool Has(const OcDbObjectId & objId) const;
+    OcApp::ErrorStatus FileOffset(const OcDbObjectId & objId, int32_t & offset) const;
+
+    /**
+     *  File offsets of the objects in ascending order, the order
+     *  DecodeObjects visits them in.
+     */
+    std::vector<int32_t> FileOffsets() const;
 
 private:
+    typedef std::pair<int32_t, int32_t> MapItem;
+
+    void BuildIndex();
+    int32_t IndexOf(int64_t handle) const;
+
+    static OcApp::ErrorStatus DecodeObject(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                           const MapItem & item, ObjectHeader & obj);
+    std::vector<int32_t> FileOrder() const;
+    OcApp::ErrorStatus DecodeObjects(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                     const std::vector<int32_t> & order,
+                                     size_t begin, size_t end);
+    OcApp::ErrorStatus DecodeObjectsParallel(OcBsStreamIn & in, const OcBsDwgClasses & classes,
+                                             const std::vector<int32_t> & order,
+                                             int nThreads);
+
     int32_t m_objMapFilePos;
     int32_t m_objMapSize;
 
-    typedef std::pair<int32_t, int32_t> MapItem;
     std::vector<std::pair<int32_t, int32_t> > m_objMapItems;
+    std::vector<ObjectHeader> m_objects;
+    // held by Object, for pIn's cursor and m_objects
+    std::mutex m_objectMutex;
+
+    // Position in m_objMapItems by handle. Either a direct table starting
+    // at m_indexBase (-1 for unused handles), or (handle, position) pairs
+    // sorted by handle when the handles are too sparse for a table.
+    int64_t m_indexBase;
+    std::vector<int32_t> m_denseIndex;
+    std::vector<std::pair<int32_t, int32_t> > m_sortedIndex;
 };
 
 END_OCTAVARIUM_NS
\ No newline at end of file
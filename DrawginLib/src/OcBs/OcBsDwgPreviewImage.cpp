@@ -60,19 +60,19 @@ OcBsDwgPreviewImage::~OcBsDwgPreviewImage(void)
     VLOG_FUNC_NAME;
 }
 
-const std::vector<byte_t> & OcBsDwgPreviewImage::HeaderData() const
+const OcBsDwgPreviewImage::Blob & OcBsDwgPreviewImage::HeaderData() const
 {
     VLOG_FUNC_NAME;
     return m_hdrData;
 }
 
-const std::vector<byte_t> & OcBsDwgPreviewImage::BmpData() const
+const OcBsDwgPreviewImage::Blob & OcBsDwgPreviewImage::BmpData() const
 {
     VLOG_FUNC_NAME;
     return m_bmpData;
 }
 
-const std::vector<byte_t> & OcBsDwgPreviewImage::WmfData() const
+const OcBsDwgPreviewImage::Blob & OcBsDwgPreviewImage::WmfData() const
 {
     VLOG_FUNC_NAME;
     return m_wmfData;
@@ -91,12 +91,14 @@ OcApp::ErrorStatus OcBsDwgPreviewImage::ReadDwg(OcBsStreamIn & in)
         return OcApp::eInvalidImageDataSentinel;
     }
 
-    size_t overallSize;
+    int32_t overallSize;
     char imagesPresent;
     in >> ((bitcode::RL&) overallSize);
     std::streamoff nextSentinel = in.FilePosition() + overallSize;
     in >> ((bitcode::RC&) imagesPresent);
     std::streamoff headerDataBegin = 0, bmpDataBegin = 0, wmfDataBegin = 0;
+    m_copy.clear();
+    m_hdrData = m_bmpData = m_wmfData = Blob();
 
     for(auto i = 0; i < imagesPresent; ++i)
     {
@@ -108,61 +110,85 @@ OcApp::ErrorStatus OcBsDwgPreviewImage::ReadDwg(OcBsStreamIn & in)
         {
             in >> ((bitcode::RL&) headerDataBegin);
             in >> ((bitcode::RL&) dataSize);
-            m_hdrData.resize(dataSize);
+            m_hdrData.size = dataSize;
         }
         else if(code == 2)
         {
             in >> ((bitcode::RL&) bmpDataBegin);
             in >> ((bitcode::RL&) dataSize);
-            m_bmpData.resize(dataSize);
+            m_bmpData.size = dataSize;
         }
         else if(code == 3)
         {
             in >> ((bitcode::RL&) wmfDataBegin);
             in >> ((bitcode::RL&) dataSize);
-            m_wmfData.resize(dataSize);
+            m_wmfData.size = dataSize;
         }
         else
         {
             return OcApp::eInvalidImageDataCode;
         }
-    }
 
-    if(m_hdrData.size())
-    {
-        if(in.FilePosition() != headerDataBegin)
+        if(dataSize < 0)
         {
-            return OcApp::eMismatchedFilePosition;
+            return OcApp::eInvalidImageDataCode;
         }
+    }
 
-        in.ReadRC((bitcode::RC*)&m_hdrData[0], m_hdrData.size());
-        if(!IsHeaderDataAllNULL(m_hdrData))
+    // The header, bmp and wmf data follow the directory in that order,
+    // with the end sentinel right after them.
+    const std::streamoff dataBegin = in.FilePosition();
+    std::streamoff dataEnd = dataBegin;
+    const std::pair<Blob *, std::streamoff> images[] =
+    {
+        std::make_pair(&m_hdrData, headerDataBegin),
+        std::make_pair(&m_bmpData, bmpDataBegin),
+        std::make_pair(&m_wmfData, wmfDataBegin),
+    };
+    for(auto & image : images)
+    {
+        if(image.first->size)
         {
-            return OcApp::eUnknownHeaderDataValues;
+            if(image.second != dataEnd)
+            {
+                return OcApp::eMismatchedFilePosition;
+            }
+            dataEnd += image.first->size;
         }
     }
 
-    if(m_bmpData.size())
+    if(nextSentinel != dataEnd || dataEnd > in.FileLength())
     {
-        if(in.FilePosition() != bmpDataBegin)
+        return OcApp::eMismatchedFilePosition;
+    }
+
+    const byte_t * pData;
+    if(in.Data())
+    {
+        pData = in.Data() + dataBegin;
+        in.Seek(dataEnd);
+    }
+    else
+    {
+        m_copy.resize((size_t)(dataEnd - dataBegin));
+        if(!m_copy.empty())
         {
-            return OcApp::eMismatchedFilePosition;
+            in.ReadRC((bitcode::RC*) &m_copy[0], m_copy.size());
         }
-        in.ReadRC((bitcode::RC*)&m_bmpData[0], m_bmpData.size());
+        pData = m_copy.data();
     }
 
-    if(m_wmfData.size())
+    for(auto & image : images)
     {
-        if(in.FilePosition() != wmfDataBegin)
+        if(image.first->size)
         {
-            return OcApp::eMismatchedFilePosition;
+            image.first->pData = pData + (image.second - dataBegin);
         }
-        in.ReadRC((bitcode::RC*)&m_bmpData[0], m_wmfData.size());
     }
 
-    if(nextSentinel != in.FilePosition())
+    if(m_hdrData.size && !IsHeaderDataAllNULL(m_hdrData))
     {
-        return OcApp::eMismatchedFilePosition;
+        return OcApp::eUnknownHeaderDataValues;
     }
 
     in.ReadRC(sentinelData, 16);
@@ -173,10 +199,11 @@ OcApp::ErrorStatus OcBsDwgPreviewImage::ReadDwg(OcBsStreamIn & in)
     return OcApp::eOk;
 }
 
-bool OcBsDwgPreviewImage::IsHeaderDataAllNULL(const std::vector<byte_t>& data) const
+bool OcBsDwgPreviewImage::IsHeaderDataAllNULL(const Blob & data) const
 {
     VLOG_FUNC_NAME;
-    return data.end() != std::find_if(data.begin(), data.end(),
+    const byte_t * pEnd = data.pData + data.size;
+    return pEnd != std::find_if(data.pData, pEnd,
                                       [](int x)
     {
         return x == 0;
@@ -52,21 +52,36 @@ class OcBsStreamIn;
 class OcBsDwgPreviewImage
 {
 public:
+    /**
+     *  One of the images in the section. Points into the stream's memory
+     *  when it decodes from memory, so stays valid as long as the stream
+     *  does, otherwise into a copy owned by OcBsDwgPreviewImage.
+     */
+    struct Blob
+    {
+        Blob() : pData(nullptr), size(0) {}
+        const byte_t * pData;
+        size_t size;
+    };
+
     OcBsDwgPreviewImage(void);
     virtual ~OcBsDwgPreviewImage(void);
     OcApp::ErrorStatus ReadDwg(OcBsStreamIn & in);
 
-    const std::vector<byte_t> & HeaderData() const;
-    const std::vector<byte_t> & BmpData() const;
-    const std::vector<byte_t> & WmfData() const;
+    const Blob & HeaderData() const;
+    const Blob & BmpData() const;
+    const Blob & WmfData() const;
 
 private:
 
-    bool IsHeaderDataAllNULL(const std::vector<byte_t>& data) const;
+    bool IsHeaderDataAllNULL(const Blob & data) const;
 
-    std::vector<byte_t> m_hdrData;
-    std::vector<byte_t> m_bmpData;
-    std::vector<byte_t> m_wmfData;
+    // the images are stored back to back, copied with one read when the
+    // stream isn't in memory
+    std::vector<byte_t> m_copy;
+    Blob m_hdrData;
+    Blob m_bmpData;
+    Blob m_wmfData;
 };
 
 END_OCTAVARIUM_NS
\ No newline at end of file
@@ -91,7 +91,7 @@ OcApp::ErrorStatus OcBsDwgSecondFileHeader::ReadDwg(OcBsStreamIn & in)
         return OcApp::eInvalidSecondHeaderSentinel;
     }
 
-    in.SetCalcedCRC(0xc0c1);
+    auto crcStart = in.FilePosition();
 
     int32_t hdrSize;
     BS_STREAMIN(bitcode::RL, in, hdrSize, "second file header size");
@@ -157,7 +157,8 @@ OcApp::ErrorStatus OcBsDwgSecondFileHeader::ReadDwg(OcBsStreamIn & in)
     }
 
     // calc section crc, LSB order
-    uint16_t crc, calcedCrc = in.CalcedCRC();
+    in.AdvanceToByteBoundary();
+    uint16_t crc, calcedCrc = in.CalcCRC(crcStart, in.FilePosition());
     in.ReadCRC(crc);
     if(crc != calcedCrc)
     {
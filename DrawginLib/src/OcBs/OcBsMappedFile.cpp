@@ -0,0 +1,264 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include "OcCommon.h"
+#include "OcError.h"
+#include "OcBsMappedFile.h"
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+BEGIN_OCTAVARIUM_NS
+
+OcBsMappedFile::OcBsMappedFile(void)
+    : m_pData(nullptr), m_size(0)
+#ifdef _WIN32
+    , m_hFile(INVALID_HANDLE_VALUE), m_hMapping(NULL)
+#else
+    , m_fd(-1)
+#endif
+{
+    VLOG_FUNC_NAME;
+}
+
+OcBsMappedFile::~OcBsMappedFile(void)
+{
+    VLOG_FUNC_NAME;
+    Close();
+}
+
+#ifdef _WIN32
+
+OcApp::ErrorStatus OcBsMappedFile::Open(const std::string & filename)
+{
+    VLOG_FUNC_NAME;
+    Close();
+
+    m_hFile = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(m_hFile == INVALID_HANDLE_VALUE)
+    {
+        LOG(ERROR) << "Unable to open file for mapping: " << filename;
+        return OcApp::eFileNotFound;
+    }
+
+    LARGE_INTEGER fileSize;
+    if(!::GetFileSizeEx(m_hFile, &fileSize))
+    {
+        Close();
+        return OcApp::eCouldNotDetermineFileSize;
+    }
+
+    if(fileSize.QuadPart == 0)
+    {
+        Close();
+        return OcApp::eFileSizeIsZero;
+    }
+
+    m_hMapping = ::CreateFileMappingA(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(m_hMapping == NULL)
+    {
+        LOG(ERROR) << "CreateFileMapping failed, error " << ::GetLastError();
+        Close();
+        return OcApp::eCreateFileMapping;
+    }
+
+    m_pData = (const uint8_t *)::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if(m_pData == nullptr)
+    {
+        LOG(ERROR) << "MapViewOfFile failed, error " << ::GetLastError();
+        Close();
+        return OcApp::eMapViewOfFile;
+    }
+
+    m_size = (std::streamsize) fileSize.QuadPart;
+    return OcApp::eOk;
+}
+
+void OcBsMappedFile::Close(void)
+{
+    VLOG_FUNC_NAME;
+
+    if(m_pData && !::UnmapViewOfFile(m_pData))
+    {
+        LOG(ERROR) << "UnmapViewOfFile failed, error " << ::GetLastError();
+    }
+
+    if(m_hMapping != NULL)
+    {
+        ::CloseHandle(m_hMapping);
+    }
+
+    if(m_hFile != INVALID_HANDLE_VALUE)
+    {
+        ::CloseHandle(m_hFile);
+    }
+
+    m_pData = nullptr;
+    m_size = 0;
+    m_hMapping = NULL;
+    m_hFile = INVALID_HANDLE_VALUE;
+}
+
+void OcBsMappedFile::Advise(AccessPattern /*pattern*/)
+{
+    VLOG_FUNC_NAME;
+}
+
+#else
+
+OcApp::ErrorStatus OcBsMappedFile::Open(const std::string & filename)
+{
+    VLOG_FUNC_NAME;
+    Close();
+
+    m_fd = ::open(filename.c_str(), O_RDONLY);
+    if(m_fd == -1)
+    {
+        LOG(ERROR) << "Unable to open file for mapping: " << filename;
+        return OcApp::eFileNotFound;
+    }
+
+    struct stat fileStat;
+    if(::fstat(m_fd, &fileStat) == -1)
+    {
+        Close();
+        return OcApp::eGettingFileStatus;
+    }
+
+    if(!S_ISREG(fileStat.st_mode))
+    {
+        LOG(ERROR) << "Invalid filetype, input file name is not a regular file.";
+        Close();
+        return OcApp::eGettingFileAttributes;
+    }
+
+    if(fileStat.st_size == 0)
+    {
+        Close();
+        return OcApp::eFileSizeIsZero;
+    }
+
+    void * pView = ::mmap(NULL, (size_t) fileStat.st_size, PROT_READ,
+                          MAP_PRIVATE, m_fd, 0);
+    if(pView == MAP_FAILED)
+    {
+        LOG(ERROR) << "mmap failed for file: " << filename;
+        Close();
+        return OcApp::eMapViewOfFile;
+    }
+
+    m_pData = (const uint8_t *) pView;
+    m_size = (std::streamsize) fileStat.st_size;
+    return OcApp::eOk;
+}
+
+void OcBsMappedFile::Close(void)
+{
+    VLOG_FUNC_NAME;
+
+    if(m_pData && ::munmap((void *) m_pData, (size_t) m_size) == -1)
+    {
+        LOG(ERROR) << "munmap failed";
+    }
+
+    if(m_fd != -1)
+    {
+        ::close(m_fd);
+    }
+
+    m_pData = nullptr;
+    m_size = 0;
+    m_fd = -1;
+}
+
+void OcBsMappedFile::Advise(AccessPattern pattern)
+{
+    VLOG_FUNC_NAME;
+
+    if(!m_pData)
+    {
+        return;
+    }
+
+    int advice = MADV_NORMAL;
+    if(pattern == eSequential)
+    {
+        advice = MADV_SEQUENTIAL;
+    }
+    else if(pattern == eRandom)
+    {
+        advice = MADV_RANDOM;
+    }
+
+    ::madvise((void *) m_pData, (size_t) m_size, advice);
+}
+
+#endif
+
+bool OcBsMappedFile::IsOpen(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pData != nullptr;
+}
+
+const uint8_t * OcBsMappedFile::Data(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pData;
+}
+
+std::streamsize OcBsMappedFile::Size(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_size;
+}
+
+END_OCTAVARIUM_NS
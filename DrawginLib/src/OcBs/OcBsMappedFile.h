@@ -0,0 +1,92 @@
+/**
+ *	@file
+ *  @brief Defines OcBsMappedFile class
+ *
+ *  Read only memory mapped view of a drawing file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+BEGIN_OCTAVARIUM_NS
+
+/**
+ *  Maps an entire file into the address space of the process, read only.
+ *  The mapping is released when the object is closed or destroyed.
+ */
+class OcBsMappedFile
+{
+    DISABLE_COPY(OcBsMappedFile);
+public:
+    /**
+     *  How the mapped view is about to be read, a hint for the kernel's
+     *  read ahead.
+     */
+    enum AccessPattern { eNormal = 0, eSequential, eRandom, };
+
+    OcBsMappedFile(void);
+    virtual ~OcBsMappedFile(void);
+
+    OcApp::ErrorStatus Open(const std::string & filename);
+    void Close(void);
+
+    /**
+     *  Passes pattern on to madvise. Windows has no per view hint, the
+     *  call does nothing there.
+     */
+    void Advise(AccessPattern pattern);
+
+    bool IsOpen(void) const;
+    const uint8_t * Data(void) const;
+    std::streamsize Size(void) const;
+
+private:
+    const uint8_t * m_pData;
+    std::streamsize m_size;
+#ifdef _WIN32
+    void * m_hFile;
+    void * m_hMapping;
+#else
+    int m_fd;
+#endif
+};
+
+END_OCTAVARIUM_NS
@@ -0,0 +1,219 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include "OcCommon.h"
+#include "OcError.h"
+#include "OcBsStream.h"
+#include "OcBsReadahead.h"
+
+BEGIN_OCTAVARIUM_NS
+
+namespace
+{
+// Ranges are read in chunks so Stop doesn't wait on one large read.
+const std::streamsize chunkSize = 256 * 1024;
+const std::streamsize pageSize = 4096;
+}
+
+OcBsReadahead::OcBsReadahead(void)
+    : m_stop(false), m_pData(nullptr), m_size(0)
+{
+    VLOG_FUNC_NAME;
+}
+
+OcBsReadahead::~OcBsReadahead(void)
+{
+    VLOG_FUNC_NAME;
+    Stop();
+}
+
+void OcBsReadahead::Start(const OcBsStream & stream)
+{
+    VLOG_FUNC_NAME;
+    DCHECK(!m_thread.joinable()) << "Readahead already started";
+
+    if(stream.Filename().empty())
+    {
+        return;
+    }
+
+    m_pData = stream.Data();
+    m_size = stream.FileLength();
+    m_filename = stream.Filename();
+    m_stop = false;
+    m_thread = std::thread(&OcBsReadahead::Run, this);
+}
+
+void OcBsReadahead::Add(std::streamoff nStart, std::streamoff nEnd)
+{
+    VLOG_FUNC_NAME;
+
+    nStart = std::max<std::streamoff>(nStart, 0);
+    if(nEnd <= nStart)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_ranges.empty() && nStart <= m_ranges.back().second &&
+            nEnd >= m_ranges.back().first)
+    {
+        Range & last = m_ranges.back();
+        last.first = std::min(last.first, nStart);
+        last.second = std::max(last.second, nEnd);
+    }
+    else
+    {
+        m_ranges.push_back(Range(nStart, nEnd));
+    }
+    m_wake.notify_one();
+}
+
+void OcBsReadahead::Stop(void)
+{
+    VLOG_FUNC_NAME;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_ranges.clear();
+        m_wake.notify_one();
+    }
+
+    if(m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void OcBsReadahead::Run(void)
+{
+    VLOG_FUNC_NAME;
+    std::ifstream fs;
+    std::vector<char> buffer;
+
+    if(m_pData == nullptr)
+    {
+        // a stream of its own, so the decoder's file position and buffer
+        // are never touched from this thread.
+        fs.open(m_filename.c_str(), std::ios::in | std::ios::binary);
+        if(!fs)
+        {
+            VLOG(4) << "Readahead could not open " << m_filename;
+            return;
+        }
+    }
+
+    Range range;
+    while(Next(range))
+    {
+        // offsets come from the file, keep them inside the mapping
+        range.first = std::max<std::streamoff>(range.first, 0);
+        range.second = std::min<std::streamoff>(range.second, m_size);
+        if(range.first >= range.second)
+        {
+            continue;
+        }
+
+        if(m_pData)
+        {
+            TouchPages(range);
+        }
+        else
+        {
+            ReadFile(fs, buffer, range);
+        }
+    }
+}
+
+bool OcBsReadahead::Next(Range & range)
+{
+    VLOG_FUNC_NAME;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake.wait(lock, [this] { return m_stop || !m_ranges.empty(); });
+
+    if(m_stop)
+    {
+        return false;
+    }
+
+    // hand out one chunk at a time, leaving the rest queued so ranges
+    // added meanwhile can still merge with it.
+    Range & front = m_ranges.front();
+    range.first = front.first;
+    range.second = std::min<std::streamoff>(front.second, front.first + chunkSize);
+    front.first = range.second;
+    if(front.first >= front.second)
+    {
+        m_ranges.pop_front();
+    }
+    return true;
+}
+
+void OcBsReadahead::TouchPages(const Range & range)
+{
+    VLOG_FUNC_NAME;
+    // reading one byte per page is enough to fault the page in
+    volatile uint8_t sink = 0;
+    for(std::streamoff pos = range.first; pos < range.second; pos += pageSize)
+    {
+        sink ^= m_pData[pos];
+    }
+    (void) sink;
+}
+
+void OcBsReadahead::ReadFile(std::ifstream & fs, std::vector<char> & buffer,
+                             const Range & range)
+{
+    VLOG_FUNC_NAME;
+    if(range.second <= range.first)
+    {
+        return;
+    }
+
+    buffer.resize((size_t)(range.second - range.first));
+    fs.clear();
+    fs.seekg(range.first);
+    fs.read(buffer.data(), buffer.size());
+}
+
+END_OCTAVARIUM_NS
@@ -0,0 +1,112 @@
+/**
+ *	@file
+ *  @brief Defines OcBsReadahead class
+ *
+ *  Background reader that warms the file ranges the decoder will visit next
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+BEGIN_OCTAVARIUM_NS
+
+class OcBsStream;
+
+/**
+ *  Reads byte ranges of a drawing on a background thread ahead of the
+ *  decoder, so the decoder finds them in the OS file cache (or, for a
+ *  memory mapped view, already paged in) instead of stalling on the disk.
+ *  Ranges are read in the order they are added, adjacent and overlapping
+ *  ranges are merged. Nothing is handed to the decoder, the stream reads
+ *  the bytes as usual; the readahead only affects how long that takes.
+ */
+class OcBsReadahead
+{
+    DISABLE_COPY(OcBsReadahead);
+public:
+    OcBsReadahead(void);
+    virtual ~OcBsReadahead(void);
+
+    /**
+     *  Starts reading the ranges of the file behind stream. Does nothing
+     *  if stream decodes a caller supplied buffer, which is already in
+     *  memory.
+     */
+    void Start(const OcBsStream & stream);
+
+    /**
+     *  Queues [nStart, nEnd) to be read. May be called before or after
+     *  Start.
+     */
+    void Add(std::streamoff nStart, std::streamoff nEnd);
+
+    /**
+     *  Drops any queued ranges and waits for the background thread to
+     *  finish. Called by the destructor.
+     */
+    void Stop(void);
+
+private:
+    typedef std::pair<std::streamoff, std::streamoff> Range;
+
+    void Run(void);
+    bool Next(Range & range);
+    void TouchPages(const Range & range);
+    void ReadFile(std::ifstream & fs, std::vector<char> & buffer, const Range & range);
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Range> m_ranges;
+    std::atomic<bool> m_stop;
+    std::thread m_thread;
+
+    const uint8_t * m_pData;
+    std::streamsize m_size;
+    std::string m_filename;
+};
+
+END_OCTAVARIUM_NS
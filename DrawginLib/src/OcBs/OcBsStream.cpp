@@ -43,6 +43,8 @@
 #include "OcCommon.h"
 #include "OcError.h"
 #include "OcBsStream.h"
+#include "OcBsDwgCrc.h"
+#include "OcBsDwgCodepage.h"
 
 #ifndef S_ISDIR
 #define S_ISDIR(mode) (((mode) & S_IFMT) == S_IFDIR)
@@ -63,8 +65,9 @@ BEGIN_OCTAVARIUM_NS
 
 OcBsStream::OcBsStream()
     : m_filePosition(0), m_fileLength(0), m_bitPosition(0),
-      m_indexSize(0), m_crc(0), m_version(NONE), m_convertCodepage(false),
-      m_bSeekedOnBufferBoundary(false), m_streamError(OcApp::eOk)
+      m_pView(nullptr), m_viewPosition(0), m_viewSize(0),
+      m_pData(nullptr), m_version(NONE), m_codePage(0), m_pCodepage(nullptr),
+      m_streamError(OcApp::eOk)
 {
     VLOG_FUNC_NAME;
 }
@@ -79,59 +82,126 @@ OcBsStream::~OcBsStream()
 void OcBsStream::Close()
 {
     VLOG_FUNC_NAME;
-    m_fileLength = m_filePosition = m_indexSize = 0;
+    m_fileLength = m_filePosition = m_viewPosition = m_viewSize = 0;
     m_bitPosition = 0;
-    m_cache = 0;
+    m_pView = m_pData = nullptr;
+    m_filename.clear();
+    m_mappedFile.Close();
+
+    if(m_fs.is_open())
+    {
+        m_fs.close();
+    }
 }
 
 
 uint8_t OcBsStream::Get(int nBits)
 {
     VLOG_FUNC_NAME;
-    std::streamsize pos = m_filePosition % BUFSIZE;
-
-    if(pos == 0 && !m_bSeekedOnBufferBoundary)
-    {
-        m_fs.read((char *) &m_buffer, BUFSIZE);
-        m_indexSize = std::min(m_fs.gcount(), m_fileLength
-                               - (std::streamsize)m_filePosition);
-    }
-
+    uint8_t byte = *Fetch(m_filePosition, 1);
     m_filePosition += nBits / CHAR_BIT;
     m_bitPosition = (m_bitPosition + nBits) % CHAR_BIT;
-    return m_buffer[(size_t)pos];
+    return byte;
 }
 
 uint8_t OcBsStream::Get()
 {
     VLOG_FUNC_NAME;
-    std::streamsize pos = m_filePosition % BUFSIZE;
+    return *Fetch(m_filePosition, 1);
+}
+
+uint8_t OcBsStream::PeekAhead()
+{
+    VLOG_FUNC_NAME;
+    return *Fetch(m_filePosition + 1, 1);
+}
 
-    if(pos == 0 && !m_bSeekedOnBufferBoundary)
+const uint8_t * OcBsStream::FetchSlow(std::streamoff nPos, int nBytes)
+{
+    VLOG_FUNC_NAME;
+    DCHECK(nBytes <= MAX_FETCH) << "Fetch request too large";
+
+    if(!m_pData)
+    {
+        FillBuffer(nPos);
+
+        if(nPos + nBytes <= m_viewPosition + m_viewSize)
+        {
+            return m_pView + (nPos - m_viewPosition);
+        }
+    }
+
+    // The request runs off the end of the file (or starts before it),
+    // hand back a 0 padded copy of whatever part is available.
+    m_tail.fill(0);
+
+    for(int i = 0; i < nBytes; ++i)
     {
-        m_fs.read((char *) &m_buffer, BUFSIZE);
-        m_indexSize = std::min(m_fs.gcount(), m_fileLength
-                               - (std::streamsize) m_filePosition);
+        std::streamoff offset = nPos + i - m_viewPosition;
+
+        if(offset >= 0 && offset < m_viewSize)
+        {
+            m_tail[i] = m_pView[offset];
+        }
     }
 
-    return m_buffer[(size_t)pos];
+    return m_tail.data();
 }
 
-uint8_t OcBsStream::PeekAhead()
+void OcBsStream::CopyBytes(std::streamoff nPos, uint8_t * pDst, size_t size)
 {
     VLOG_FUNC_NAME;
-    m_filePosition++;
-    uint8_t byte = Get();
-    m_filePosition--;
-    return byte;
-}
+    std::streamoff nEnd = nPos + (std::streamoff) size;
+    std::streamoff nAvail = std::min<std::streamoff>(nEnd, m_fileLength);
+
+    // whatever part of the request the current view already holds
+    std::streamoff viewEnd = m_viewPosition + m_viewSize;
+
+    if(nPos < nAvail && nPos >= m_viewPosition && nPos < viewEnd)
+    {
+        size_t n = (size_t)(std::min(nAvail, viewEnd) - nPos);
+        memcpy(pDst, m_pView + (nPos - m_viewPosition), n);
+        pDst += n;
+        nPos += n;
+    }
+
+    if(nPos < nAvail && !m_pData)
+    {
+        if(m_fs.eof())
+        {
+            m_fs.clear();
+        }
+
+        m_fs.seekg(nPos, ios::beg);
+        m_fs.read((char *) pDst, nAvail - nPos);
+        m_counters.refills++;
+        std::streamsize nRead = std::max<std::streamsize>(0, m_fs.gcount());
+        pDst += nRead;
+        nPos += nRead;
+    }
 
+    if(nPos < nEnd)
+    {
+        memset(pDst, 0, (size_t)(nEnd - nPos));
+    }
+}
 
-bitcode::T OcBsStream::ConvertToCodepage(bitcode::T & t)
+void OcBsStream::FillBuffer(std::streamoff nPos)
 {
     VLOG_FUNC_NAME;
-    LOG(ERROR) << "OcBsString::ConvertToCodepage not implemented, returning original string";
-    return t;
+
+    if(m_fs.eof())
+    {
+        m_fs.clear();
+    }
+
+    m_fs.seekg(nPos, ios::beg);
+    m_fs.read((char *) &m_buffer, BUFSIZE);
+    m_counters.refills++;
+    m_pView = m_buffer.data();
+    m_viewPosition = nPos;
+    m_viewSize = std::max<std::streamsize>(0, std::min(m_fs.gcount(),
+                                                         m_fileLength - nPos));
 }
 
 std::streamoff OcBsStream::FilePosition() const
@@ -140,6 +210,51 @@ std::streamoff OcBsStream::FilePosition() const
     return m_filePosition;
 }
 
+int64_t OcBsStream::BitOffset() const
+{
+    VLOG_FUNC_NAME;
+    return (int64_t) m_filePosition * CHAR_BIT + m_bitPosition;
+}
+
+const OcBsStream::IoCounters & OcBsStream::Counters() const
+{
+    VLOG_FUNC_NAME;
+    return m_counters;
+}
+
+void OcBsStream::AddCounters(const IoCounters & counters)
+{
+    VLOG_FUNC_NAME;
+    m_counters.bitsRead += counters.bitsRead;
+    m_counters.seeks += counters.seeks;
+    m_counters.refills += counters.refills;
+    m_counters.crcBytes += counters.crcBytes;
+}
+
+std::streamsize OcBsStream::FileLength() const
+{
+    VLOG_FUNC_NAME;
+    return m_fileLength;
+}
+
+const std::string & OcBsStream::Filename() const
+{
+    VLOG_FUNC_NAME;
+    return m_filename;
+}
+
+const uint8_t * OcBsStream::Data() const
+{
+    VLOG_FUNC_NAME;
+    return m_pData;
+}
+
+void OcBsStream::Advise(OcBsMappedFile::AccessPattern pattern)
+{
+    VLOG_FUNC_NAME;
+    m_mappedFile.Advise(pattern);
+}
+
 const int OcBsStream::BufferSize()
 {
     VLOG_FUNC_NAME;
@@ -164,37 +279,96 @@ void OcBsStream::SetVersion(DWG_VERSION version)
     m_version = version;
 }
 
-uint16_t OcBsStream::CalcedCRC(bool bRetResultInMSB /*= false*/) const
+int16_t OcBsStream::CodePage() const
 {
     VLOG_FUNC_NAME;
-    // when bRetResultInMSB is true then some bit twiddling is done
-    // that expects m_crc to be a 16 bit integer. Assert if not.
-    DCHECK(sizeof(m_crc) == sizeof(uint16_t))
-            << "size of m_crc must be a 16 bit integer";
+    return m_codePage;
+}
 
-    if(bRetResultInMSB)
+void OcBsStream::SetCodePage(int16_t dwgCodePage)
+{
+    VLOG_FUNC_NAME;
+    m_codePage = dwgCodePage;
+    m_pCodepage = OcBsDwgCodepage::Get(dwgCodePage);
+}
+
+void OcBsStream::ShareCodePage(const OcBsStream & stream)
+{
+    VLOG_FUNC_NAME;
+    m_codePage = stream.m_codePage;
+    m_pCodepage = stream.m_pCodepage;
+}
+
+uint16_t OcBsStream::CalcCRC(std::streamoff nStart, std::streamoff nEnd,
+                             uint16_t seed /*= 0xc0c1*/)
+{
+    VLOG_FUNC_NAME;
+    nStart = std::max<std::streamoff>(nStart, 0);
+    nEnd = std::min<std::streamoff>(nEnd, m_fileLength);
+
+    if(nStart >= nEnd)
     {
-        uint16_t crc = m_crc;
-        byte_t * pCrc = (byte_t *) &crc;
-        // XOR byte swap
-        (pCrc[0] ^= pCrc[1]), (pCrc[1] ^= pCrc[0]), (pCrc[0] ^= pCrc[1]);
-        return crc;
+        return seed;
     }
 
-    return m_crc;
+    m_counters.crcBytes += nEnd - nStart;
+
+    if(m_pData)
+    {
+        return crc8Span(seed, m_pData + nStart, (size_t)(nEnd - nStart));
+    }
+
+    // Walk the range a buffer at a time. The next Fetch notices the view
+    // moved and refills from the current file position.
+    uint16_t crc = seed;
+
+    for(std::streamoff pos = nStart; pos < nEnd; pos += m_viewSize)
+    {
+        FillBuffer(pos);
+
+        if(m_viewSize <= 0)
+        {
+            break;
+        }
+
+        std::streamsize n = std::min<std::streamsize>(m_viewSize, nEnd - pos);
+        crc = crc8Span(crc, m_pView, (size_t) n);
+    }
+
+    return crc;
 }
 
-void OcBsStream::SetCalcedCRC(uint16_t crc)
+std::future<uint16_t> OcBsStream::CalcCRCAsync(std::streamoff nStart, std::streamoff nEnd,
+                                               uint16_t seed /*= 0xc0c1*/)
 {
     VLOG_FUNC_NAME;
-    m_crc = crc;
+    nStart = std::max<std::streamoff>(nStart, 0);
+    nEnd = std::min<std::streamoff>(nEnd, m_fileLength);
+
+    if(m_pData && nStart < nEnd)
+    {
+        // the mapped view is read only and stays valid until the stream
+        // is closed, callers must get() the result before then.
+        const uint8_t * p = m_pData + nStart;
+        size_t n = (size_t)(nEnd - nStart);
+        m_counters.crcBytes += n;
+        return std::async(std::launch::async, [=]()
+        {
+            return crc8Span(seed, p, n);
+        });
+    }
+
+    std::promise<uint16_t> result;
+    result.set_value(CalcCRC(nStart, nEnd, seed));
+    return result.get_future();
 }
 
-void OcBsStream::Open(const std::string & filename, int mode)
+void OcBsStream::Open(const std::string & filename, int mode,
+                      StreamMode streamMode /*= eFileStream*/)
 {
     VLOG_FUNC_NAME;
 
-    if(m_fs.is_open())
+    if(m_fs.is_open() || m_pData)
     {
         Close();
     }
@@ -215,6 +389,25 @@ void OcBsStream::Open(const std::string & filename, int mode)
         return;
     }
 
+    if(streamMode == eMemoryMapped)
+    {
+        OcApp::ErrorStatus es = m_mappedFile.Open(filename);
+        if(es != OcApp::eOk)
+        {
+            LOG(ERROR) << "Unable to memory map the input file.";
+            m_fs.setstate(ios_base::badbit);
+            return;
+        }
+
+        m_pView = m_pData = m_mappedFile.Data();
+        m_viewPosition = 0;
+        m_viewSize = m_fileLength = m_mappedFile.Size();
+        m_filePosition = 0;
+        m_filename = filename;
+        return;
+    }
+
+    m_fs.clear();
     m_fs.open(filename.c_str(), (ios_base::openmode) mode);
 
     if(Good())
@@ -222,8 +415,34 @@ void OcBsStream::Open(const std::string & filename, int mode)
         m_fs.seekg(0, ios::end);
         m_fileLength = m_fs.tellg();
         m_fs.seekg(0, ios::beg);
-        m_cache = 0;
+        m_pView = m_buffer.data();
+        m_viewPosition = m_viewSize = 0;
+        m_filename = filename;
+    }
+}
+
+void OcBsStream::Open(const uint8_t * pData, size_t size)
+{
+    VLOG_FUNC_NAME;
+
+    if(m_fs.is_open() || m_pData)
+    {
+        Close();
     }
+
+    m_fs.clear();
+
+    if(!pData || size == 0)
+    {
+        LOG(ERROR) << "Invalid input buffer.";
+        m_fs.setstate(ios_base::badbit);
+        return;
+    }
+
+    m_pView = m_pData = pData;
+    m_viewPosition = 0;
+    m_viewSize = m_fileLength = size;
+    m_filePosition = 0;
 }
 
 OcApp::ErrorStatus OcBsStream::Error(void)
@@ -46,14 +46,18 @@
 #pragma once
 
 #include <fstream>
+#include <future>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 #include "OcBsTypes.h"
 #include "OcBsDwgVersion.h"
+#include "OcBsMappedFile.h"
 
 BEGIN_OCTAVARIUM_NS
 
+class OcBsDwgCodepage;
+
 class OcBsStream
 {
 protected:
@@ -62,6 +66,32 @@ protected:
     const static int BUFSIZE = 4096;
 
 public:
+    /**
+     *  Selects how the drawing file is read.<br>
+     *  eFileStream reads through std::fstream into a BUFSIZE buffer.<br>
+     *  eMemoryMapped maps the whole file and decodes directly from the
+     *  mapped view, so Seek never causes a read.
+     */
+    enum StreamMode { eFileStream = 0, eMemoryMapped, };
+
+    /**
+     *  Maximum number of bytes that can be requested from Fetch.
+     */
+    const static int MAX_FETCH = 16;
+
+    /**
+     *  Running totals of the stream activity, sampled by the readers to
+     *  build OcDbReadStats.
+     */
+    struct IoCounters
+    {
+        IoCounters() : bitsRead(0), seeks(0), refills(0), crcBytes(0) {}
+        uint64_t bitsRead;
+        uint64_t seeks;
+        uint64_t refills;
+        uint64_t crcBytes;
+    };
+
     OcBsStream();
     virtual ~OcBsStream();
 
@@ -79,29 +109,121 @@ public:
     uint8_t PeekAhead();
     virtual OcBsStream & Seek(std::streamoff nPos, int nBits = 0) = 0;
     virtual std::streamoff FilePosition() const;
+    std::streamsize FileLength() const;
+
+    /**
+     *  Name of the open file, empty when decoding a caller supplied buffer.
+     */
+    const std::string & Filename() const;
+
+    /**
+     *  Current read position in bits from the start of the file.
+     */
+    int64_t BitOffset() const;
+
+    const IoCounters & Counters() const;
+
+    /**
+     *  Adds the activity of another stream over the same file, for
+     *  example a worker's cursor, to this stream's counters.
+     */
+    void AddCounters(const IoCounters & counters);
+
+    /**
+     *  The complete file contents when the stream decodes from memory
+     *  (eMemoryMapped or a caller supplied buffer), otherwise nullptr.
+     *  Other streams can be opened over the same bytes.
+     */
+    const uint8_t * Data() const;
     const static int BufferSize();
 
+    /**
+     *  Read ahead hint for a memory mapped file, ignored otherwise.
+     */
+    void Advise(OcBsMappedFile::AccessPattern pattern);
+
     virtual bool Good() const = 0;
     virtual bool Eof() const = 0;
     virtual bool Fail() const = 0;
     virtual bool Bad() const = 0;
-    bitcode::T ConvertToCodepage(bitcode::T & t);
 
     operator void*() const;
 
     DWG_VERSION Version() const;
     void SetVersion(DWG_VERSION version);
 
-    uint16_t CalcedCRC(bool bRetResultInMSB = false) const;
-    void SetCalcedCRC(uint16_t crc);
+    /**
+     *  The DWG codepage of the drawing (file header 3.2.4). T strings are
+     *  converted from it when they are read.
+     */
+    int16_t CodePage() const;
+    void SetCodePage(int16_t dwgCodePage);
+
+    /**
+     *  Takes the codepage of another stream over the same drawing along
+     *  with the converter already resolved for it, so a worker's cursor
+     *  doesn't look it up again.
+     */
+    void ShareCodePage(const OcBsStream & stream);
+
+    /**
+     *  Returns the DWG crc of the raw file bytes in [nStart, nEnd), starting
+     *  from seed. Sections record where their crc coverage begins and
+     *  verify it once, after decoding, instead of the bit reader updating a
+     *  running crc.
+     */
+    uint16_t CalcCRC(std::streamoff nStart, std::streamoff nEnd,
+                     uint16_t seed = 0xc0c1);
+
+    /**
+     *  Same as CalcCRC. When the file is memory mapped the crc is
+     *  calculated on another thread while the caller keeps decoding,
+     *  otherwise the returned future is already satisfied.
+     */
+    std::future<uint16_t> CalcCRCAsync(std::streamoff nStart, std::streamoff nEnd,
+                                       uint16_t seed = 0xc0c1);
 
     virtual OcApp::ErrorStatus Error(void);
     virtual void ClearError();
     virtual void SetError(OcApp::ErrorStatus es);
 
 protected:
-    virtual void Open(const std::string & filename, int mode);
+    virtual void Open(const std::string & filename, int mode,
+                      StreamMode streamMode = eFileStream);
+
+    /**
+     *  Decodes directly from size bytes at pData. The memory is owned by
+     *  the caller and must stay valid until the stream is closed.
+     */
+    virtual void Open(const uint8_t * pData, size_t size);
+
+    /**
+     *  Returns a pointer to the file data starting at file offset nPos,
+     *  with at least nBytes (<= MAX_FETCH) readable. Bytes past the end of
+     *  the file read as 0. The pointer is only valid until the next call.
+     */
+    const uint8_t * Fetch(std::streamoff nPos, int nBytes)
+    {
+        std::streamoff offset = nPos - m_viewPosition;
 
+        if(offset >= 0 && offset + nBytes <= m_viewSize)
+        {
+            return m_pView + offset;
+        }
+
+        return FetchSlow(nPos, nBytes);
+    }
+
+    /**
+     *  Copies size bytes starting at file offset nPos into pDst. Bytes past
+     *  the end of the file are 0. Unlike Fetch there is no size limit, large
+     *  runs are read straight into pDst instead of through m_buffer.
+     */
+    void CopyBytes(std::streamoff nPos, uint8_t * pDst, size_t size);
+
+private:
+    const uint8_t * FetchSlow(std::streamoff nPos, int nBytes);
+    void FillBuffer(std::streamoff nPos);
 
 
 protected:
@@ -109,14 +231,24 @@ protected:
     std::streamoff m_filePosition;
     std::streamsize m_fileLength;
     int m_bitPosition;
-    std::streamsize m_indexSize;
-    uint16_t m_crc;
-    uint8_t m_cache;
+
+    // The bytes currently addressable without a read. For eFileStream this
+    // is m_buffer, for eMemoryMapped it is the entire mapped file.
+    const uint8_t * m_pView;
+    std::streamoff m_viewPosition;
+    std::streamsize m_viewSize;
+    std::array<uint8_t, MAX_FETCH> m_tail;
+    IoCounters m_counters;
 
     std::fstream m_fs;
+    std::string m_filename;
+    OcBsMappedFile m_mappedFile;
+    // when not null, the complete file contents, m_fileLength bytes long.
+    const uint8_t * m_pData;
     DWG_VERSION m_version;
-    bool m_convertCodepage;
-    bool m_bSeekedOnBufferBoundary;
+    int16_t m_codePage;
+    // converter for m_codePage, nullptr when T strings are used as is
+    const OcBsDwgCodepage * m_pCodepage;
     OcApp::ErrorStatus m_streamError;
 };
 
@@ -44,20 +44,85 @@
 #include "OcError.h"
 #include "OcBsStreamIn.h"
 #include "OcBsDwgCrc.h"
+#include "OcBsDwgCodepage.h"
 
 using namespace std;
 
 BEGIN_OCTAVARIUM_NS
 
+// Bits are stored MSB first, so loading 8 bytes big endian gives a register
+// whose top bit is the first bit of the byte at p.
+static inline uint64_t LoadBigEndian64(const uint8_t * p)
+{
+    return ((uint64_t) p[0] << 56) | ((uint64_t) p[1] << 48) |
+           ((uint64_t) p[2] << 40) | ((uint64_t) p[3] << 32) |
+           ((uint64_t) p[4] << 24) | ((uint64_t) p[5] << 16) |
+           ((uint64_t) p[6] << 8)  | ((uint64_t) p[7]);
+}
+
+// Raw multi byte values are little endian, ReadBits returns them with the
+// first byte in the most significant position.
+static inline uint16_t ByteSwap16(uint16_t v)
+{
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+static inline uint32_t ByteSwap32(uint32_t v)
+{
+    return (v >> 24) | ((v >> 8) & 0x0000ff00) |
+           ((v << 8) & 0x00ff0000) | (v << 24);
+}
+
+static inline uint64_t ByteSwap64(uint64_t v)
+{
+    return ((uint64_t) ByteSwap32((uint32_t) v) << 32) |
+           ByteSwap32((uint32_t)(v >> 32));
+}
+
+static inline double RawDouble(uint64_t bits)
+{
+    double d;
+    bits = ByteSwap64(bits);
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+// Converts n little endian 16 bit code units to wchar_t. Returns the index
+// of the first NUL, or n when there is none, so callers don't have to
+// rescan the string.
+static size_t WidenWords(wchar_t * pDst, const uint8_t * pSrc, size_t n)
+{
+    size_t nul = n;
+
+    for(size_t i = 0; i < n; ++i)
+    {
+        pDst[i] = (wchar_t)(pSrc[2 * i] | (pSrc[2 * i + 1] << 8));
+
+        if(pDst[i] == 0 && nul == n)
+        {
+            nul = i;
+        }
+    }
+
+    return nul;
+}
+
 OcBsStreamIn::OcBsStreamIn(void)
 {
     VLOG_FUNC_NAME;
 }
 
-OcBsStreamIn::OcBsStreamIn(const std::string & filename)
+OcBsStreamIn::OcBsStreamIn(const std::string & filename,
+                           StreamMode streamMode /*= eFileStream*/)
 {
     VLOG_FUNC_NAME;
-    Open(filename);
+    Open(filename, streamMode);
+}
+
+OcBsStreamIn::OcBsStreamIn(const uint8_t * pData, size_t size)
+{
+    VLOG_FUNC_NAME;
+    Open(pData, size);
 }
 
 OcBsStreamIn::~OcBsStreamIn(void)
@@ -65,34 +130,27 @@ OcBsStreamIn::~OcBsStreamIn(void)
     VLOG_FUNC_NAME;
 }
 
-void OcBsStreamIn::Open(const std::string & filename)
+void OcBsStreamIn::Open(const std::string & filename,
+                        StreamMode streamMode /*= eFileStream*/)
+{
+    VLOG_FUNC_NAME;
+    OcBsStream::Open(filename, fstream::in | fstream::binary, streamMode);
+}
+
+void OcBsStreamIn::Open(const uint8_t * pData, size_t size)
 {
     VLOG_FUNC_NAME;
-    OcBsStream::Open(filename, fstream::in | fstream::binary);
+    OcBsStream::Open(pData, size);
 }
 
 OcBsStreamIn & OcBsStreamIn::Seek(std::streamoff nPos, int nBit)
 {
     VLOG_FUNC_NAME;
+    // Data is fetched on demand by ReadBits, so seeking only moves the
+    // read position. Nothing is read until the next stream operation.
     m_filePosition = nPos + (nBit / CHAR_BIT);
-    std::streamoff pos = m_filePosition / BufferSize() * BufferSize();
-
-    if(m_fs.eof())
-    {
-        m_fs.clear();
-    }
-
-    m_fs.seekg(pos, ios::beg);
-    m_fs.read((char *) &m_buffer, BufferSize());
-    m_indexSize = std::min(m_fs.gcount(), m_fileLength
-                           - (std::streamsize)m_filePosition);
+    m_counters.seeks++;
     m_bitPosition = nBit % CHAR_BIT;
-    // As this seek method performs a buffer update (read) with the
-    // requested seek position, we need special handling in OcBsStream::Get
-    // when the seek position is a multiple of the buffer size.
-    // Otherwise a double read will occur leaving the wrong data in the
-    // buffer.
-    m_bSeekedOnBufferBoundary = !(m_filePosition % BufferSize());
     return *this;
 }
 
@@ -144,35 +202,65 @@ void OcBsStreamIn::AdvanceToByteBoundary(void)
     }
 }
 
+void OcBsStreamIn::SkipBits(uint64_t nBits)
+{
+    VLOG_FUNC_NAME;
+    uint64_t endBit = m_bitPosition + nBits;
+    m_filePosition += (std::streamoff)(endBit / CHAR_BIT);
+    m_bitPosition = (int)(endBit % CHAR_BIT);
+}
+
 OcBsStreamIn & OcBsStreamIn::ReadHandle(OcDbObjectId & objId)
 {
     VLOG_FUNC_NAME;
-    bitcode::BBBB code;
-    bitcode::BBBB counter;
-    *this >> code;
-    *this >> counter;
-    bitcode::RC rc;
-    int64_t val = 0;
+    // 4 bit code followed by a 4 bit counter
+    uint64_t codeAndCounter = ReadBits(8);
+    int counter = (int)(codeAndCounter & 0x0f);
+    uint64_t val = 0;
 
-    for(int i = (int) counter - 1; i >= 0; --i)
+    // handle bytes are stored MSB first
+    while(counter > 0)
     {
-        *this >> rc;
-        val |= (uint8_t)rc << (i * CHAR_BIT);
+        int nBytes = std::min(counter, 7);
+        val = (val << (nBytes * CHAR_BIT)) | ReadBits(nBytes * CHAR_BIT);
+        counter -= nBytes;
     }
 
-    objId.Handle(val);
+    objId.Handle((int64_t) val);
     return *this;
 }
 
-OcBsStreamIn & OcBsStreamIn::ReadCRC(uint16_t & crc, bool bSkipCrcTracking /*= true*/)
+uint64_t OcBsStreamIn::ReadBits(int nBits)
+{
+    VLOG_FUNC_NAME;
+    DCHECK(nBits > 0 && nBits <= 64) << "ReadBits supports 1 to 64 bits";
+
+    // With up to 7 bits already consumed from the current byte, an 8 byte
+    // register holds at least 57 unread bits. Larger requests are split.
+    if(nBits > 56)
+    {
+        uint64_t hi = ReadBits(nBits - 32);
+        return (hi << 32) | ReadBits(32);
+    }
+
+    const uint8_t * p = Fetch(m_filePosition, sizeof(uint64_t));
+    uint64_t reg = LoadBigEndian64(p);
+    uint64_t bits = (reg << m_bitPosition) >> (64 - nBits);
+    int endBit = m_bitPosition + nBits;
+    m_counters.bitsRead += nBits;
+    m_filePosition += endBit / CHAR_BIT;
+    m_bitPosition = endBit % CHAR_BIT;
+    return bits;
+}
+
+OcBsStreamIn & OcBsStreamIn::ReadCRC(uint16_t & crc)
 {
     VLOG_FUNC_NAME;
-    uint16_t currentCrc = CalcedCRC();
     // CRC are located on byte boundaries within the file.
     // if m_bitPosition is not 0 then "advance" to next
     // byte boundary. This is simply accomplished by setting
     // m_bitPosition to 0, then the next stream operation
-    // will read the next byte into m_cache. See Get()
+    // will start reading at the next byte. See ReadBits()
     // function this class.
     AdvanceToByteBoundary();
     //if(m_bitPosition != 0) {
@@ -180,66 +268,70 @@ OcBsStreamIn & OcBsStreamIn::ReadCRC(uint16_t & crc, bool bSkipCrcTracking /*= t
     //    m_filePosition++;
     //}
     *this >> (bitcode::RS&) crc;
-
-    if(bSkipCrcTracking == true)
-    {
-        SetCalcedCRC(currentCrc);
-    }
-
     return *this;
 }
 
-OcBsStreamIn & OcBsStreamIn::ReadRC(bitcode::RC * pRc, size_t size, bool bSkipCrcTracking /*= false*/)
+void OcBsStreamIn::ReadBytes(uint8_t * pDst, size_t size)
 {
     VLOG_FUNC_NAME;
-    uint16_t currentCrc = CalcedCRC();
 
-    for(size_t i = 0; i < size; ++i)
+    if(m_bitPosition == 0)
+    {
+        CopyBytes(m_filePosition, pDst, size);
+        m_filePosition += size;
+        m_counters.bitsRead += size * CHAR_BIT;
+        return;
+    }
+
+    // Not on a byte boundary, every output byte straddles two file
+    // bytes. Shift out 7 bytes per ReadBits call.
+    while(size >= 7)
     {
-        *this >> pRc[i];
+        uint64_t bits = ReadBits(56);
+
+        for(int i = 6; i >= 0; --i, bits >>= 8)
+        {
+            pDst[i] = (uint8_t) bits;
+        }
+
+        pDst += 7;
+        size -= 7;
     }
 
-    if(bSkipCrcTracking == true)
+    for(; size; --size)
     {
-        SetCalcedCRC(currentCrc);
+        *pDst++ = (uint8_t) ReadBits(8);
     }
+}
 
+OcBsStreamIn & OcBsStreamIn::ReadRC(bitcode::RC * pRc, size_t size)
+{
+    VLOG_FUNC_NAME;
+    ReadBytes((uint8_t *) pRc, size);
     return *this;
 }
 
-OcBsStreamIn & OcBsStreamIn::ReadRC(std::vector<bitcode::RC> & rc, size_t size, bool bSkipCrcTracking /*= false*/)
+OcBsStreamIn & OcBsStreamIn::ReadRC(std::vector<bitcode::RC> & rc, size_t size)
 {
     VLOG_FUNC_NAME;
-    uint16_t currentCrc = CalcedCRC();
     rc.resize(size);
 
-    for(size_t i = 0; i < size; ++i)
-    {
-        *this >> rc[i];
-    }
-
-    if(bSkipCrcTracking == true)
+    if(size)
     {
-        SetCalcedCRC(currentCrc);
+        ReadBytes((uint8_t *) &rc[0], size);
     }
 
     return *this;
 }
 
-OcBsStreamIn & OcBsStreamIn::ReadRC(std::string & rc, size_t size, bool bSkipCrcTracking /*= false*/)
+OcBsStreamIn & OcBsStreamIn::ReadRC(std::string & rc, size_t size)
 {
     VLOG_FUNC_NAME;
-    uint16_t currentCrc = CalcedCRC();
     rc.resize(size);
 
-    for(size_t i = 0; i < size; ++i)
+    if(size)
     {
-        *this >> (bitcode::RC*)&rc[i];
-    }
-
-    if(bSkipCrcTracking == true)
-    {
-        SetCalcedCRC(currentCrc);
+        ReadBytes((uint8_t *) &rc[0], size);
     }
 
     return *this;
@@ -274,52 +366,32 @@ OcBsStreamIn & OcBsStreamIn::operator>>(OcDbObjectId & objId)
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::B & b)
 {
     VLOG_FUNC_NAME;
-    b = 0;
-
-    if(m_bitPosition == 0)
-    {
-        m_cache = Get();
-        m_crc = crc8(m_crc, (const char *) &m_cache, sizeof(byte_t));
-    }
-
-    b = (m_cache & (0x80 >> m_bitPosition)) >> (7 - m_bitPosition);
-    m_filePosition += (m_bitPosition + 1) / 8;
-    m_bitPosition = (m_bitPosition + 1) % CHAR_BIT;
+    b = (uint8_t) ReadBits(1);
     return *this;
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BB & bb)
 {
     VLOG_FUNC_NAME;
-    bitcode::B b;
-    *this >> b;
-    bb = b << 1;
-    *this >> b;
-    bb |= b;
+    bb = (uint8_t) ReadBits(2);
     return *this;
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BBBB & bbbb)
 {
     VLOG_FUNC_NAME;
-    bitcode::BB bb;
-    *this >> bb;
-    bbbb = bb << 2;
-    *this >> bb;
-    bbbb |= bb;
+    bbbb = (uint8_t) ReadBits(4);
     return *this;
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BD & bd)
 {
     VLOG_FUNC_NAME;
-    bitcode::BB bb;
-    *this >> bb;
 
-    switch(bb.t)
+    switch(ReadBits(2))
     {
     case 0:
-        *this >> (bitcode::RD&)bd;
+        bd = RawDouble(ReadBits(64));
         break;
 
     case 1:
@@ -361,35 +433,21 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BD3 & bd)
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BE & be)
 {
     VLOG_FUNC_NAME;
-
-    if(m_version >= R2000)
-    {
-        be.t.set(0.0, 0.0, 1.0);
-    }
-    else
-    {
-        bitcode::BD * pbd = (bitcode::BD*)&be;
-        *this >> pbd[0] >> pbd[1] >> pbd[2];
-    }
-
-    return *this;
+    return m_version < R2000 ? ReadBE<R14>(be) : ReadBE<R2000>(be);
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BL & bl)
 {
     VLOG_FUNC_NAME;
-    bitcode::BB bb;
-    *this >> bb;
 
-    switch(bb.t)
+    switch(ReadBits(2))
     {
     case 0:
-        *this >> (bitcode::RL&)bl;
+        bl = (int32_t) ByteSwap32((uint32_t) ReadBits(32));
         break;
 
     case 1:
-        bl = 0;
-        *this >> (bitcode::RC&)bl;
+        bl = (int32_t) ReadBits(8);
         break;
 
     case 2:
@@ -407,18 +465,15 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BL & bl)
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BS & bs)
 {
     VLOG_FUNC_NAME;
-    bitcode::BB bb;
-    *this >> bb;
 
-    switch(bb.t)
+    switch(ReadBits(2))
     {
     case 0:
-        *this >> (bitcode::RS&)bs;
+        bs = (int16_t) ByteSwap16((uint16_t) ReadBits(16));
         break;
 
     case 1:
-        bs = 0; // 0 out since type RC is smaller than RS
-        *this >> (bitcode::RC&)bs;
+        bs = (int16_t) ReadBits(8);
         break;
 
     case 2:
@@ -436,48 +491,20 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BS & bs)
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::BT & bt)
 {
     VLOG_FUNC_NAME;
-    int flag = false;
-
-    if(m_version >= R2000)
-    {
-        *this >> (bitcode::B&)flag;
-    }
-
-    if(flag)
-    {
-        bt = 0.0;
-    }
-    else
-    {
-        bitcode::BD bd;
-        *this >> bd;
-        bt = bd;
-    }
-
-    return *this;
+    return m_version < R2000 ? ReadBT<R14>(bt) : ReadBT<R2000>(bt);
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::CMC & cmc)
 {
     VLOG_FUNC_NAME;
-    *this >> (bitcode::BS&)cmc.t.index;
 
-    if(m_version >= R2004)
+    // the color's names are TV, which changes again in R2007
+    if(m_version < R2004)
     {
-        *this >> (bitcode::BL&)cmc.t.rgb >> (bitcode::RC&)cmc.t.colorByte;
-
-        if(cmc.t.colorByte & 1)
-        {
-            *this >> (bitcode::TV&)cmc.t.name;
-        }
-
-        if(cmc.t.colorByte & 2)
-        {
-            *this >> (bitcode::TV&)cmc.t.bookName;
-        }
+        return ReadCMC<R2000>(cmc);
     }
 
-    return *this;
+    return m_version < R2007 ? ReadCMC<R2004>(cmc) : ReadCMC<R2007>(cmc);
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::MC & mc)
@@ -492,7 +519,7 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::MC & mc)
 
     for(int i = 3, j = 0; i >= 0; --i, j += 7)
     {
-        *this >> rc[i];
+        rc[i] = (uint8_t) ReadBits(8);
 
         if(rc[i] & 0x80)
         {
@@ -529,7 +556,7 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::MS & ms)
 
     for(int i = 1, j = 0; i >= 0; --i, j += 15)
     {
-        *this >> rs[i];
+        rs[i] = (int16_t) ByteSwap16((uint16_t) ReadBits(16));
 
         if(rs[i] & 0x8000)
         {
@@ -552,27 +579,7 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::MS & ms)
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::RC & rc)
 {
     VLOG_FUNC_NAME;
-    rc = 0;
-
-    if(m_bitPosition == 0)
-    {
-        rc = m_cache = Get();
-        m_crc = crc8(m_crc, (const char *) &m_cache, sizeof(byte_t));
-    }
-    else
-    {
-        rc = m_cache << m_bitPosition;
-
-        if(m_filePosition < m_fileLength - 1)
-        {
-            m_cache = PeekAhead();
-            m_crc = crc8(m_crc, (const char *) &m_cache, sizeof(byte_t));
-            rc |= m_cache >> (8 - m_bitPosition);
-        }
-    }
-
-    m_filePosition += (m_bitPosition + 8) / 8;
-    m_bitPosition = (m_bitPosition + 8) % CHAR_BIT;
+    rc = (uint8_t) ReadBits(8);
     return *this;
 }
 
@@ -585,15 +592,7 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::RC  rc[])
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::RD & rd)
 {
     VLOG_FUNC_NAME;
-    bitcode::RC rc;
-    byte_t * rVal = (byte_t*)&rd;
-
-    for(int i = 0; i < 8; ++i)
-    {
-        *this >> rc;
-        rVal[i] = rc;
-    }
-
+    rd = RawDouble(ReadBits(64));
     return *this;
 }
 
@@ -619,113 +618,90 @@ OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::RD3 & rd3)
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::RL & rl)
 {
     VLOG_FUNC_NAME;
-    bitcode::RS rs;
-    *this >> rs;
-    rl = (uint16_t)rs;
-    *this >> rs;
-    rl |= ((uint16_t)rs << 16);
+    rl = (int32_t) ByteSwap32((uint32_t) ReadBits(32));
     return *this;
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::RS & rs)
 {
     VLOG_FUNC_NAME;
-    bitcode::RC rc;
-    *this >> rc;
-    rs = (uint8_t)rc;
-    *this >> rc;
-    rs |= ((uint8_t)rc << 8);
+    rs = (int16_t) ByteSwap16((uint16_t) ReadBits(16));
     return *this;
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::TV & tv)
 {
     VLOG_FUNC_NAME;
+    return m_version < R2007 ? ReadTV<R2004>(tv) : ReadTV<R2007>(tv);
+}
 
-    if(m_version < R2007)
-    {
-        *this >> (bitcode::T&) tv;
-    }
-    else
+// Drops the trailing NUL of a decoded T or TU string. nul is the index of
+// the first NUL, which must not be inside the string.
+static void FinishText(std::wstring & str, size_t nul)
+{
+    // don't keep the trailing null ('\0')
+    if(!str.empty() && str[str.size() - 1] == L'\0')
     {
-        *this >> (bitcode::TU&) tv;
+        str.resize(str.size() - 1);
     }
 
-    return *this;
+    // check if NULL is embedded in the string space.
+    // If there is, then the string space may represent
+    // a string array. Will need to investigate and
+    // code appropriately.
+    // For now just debug check.
+    DCHECK(nul >= str.size()) << "NUL embedded in a text string";
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::T & t)
 {
     VLOG_FUNC_NAME;
-    t.t.clear();
     bitcode::BS length;
     *this >> length;
+    int n = std::max<int>(length.t, 0);
+
+    // Read the whole run and convert it in one pass, the pass also finds
+    // the first NUL.
+    m_text.resize(n);
+    t.t.resize(n);
+    size_t nul = n;
 
-    for(int i = 0; i < length.t; ++i)
+    if(n)
     {
-        bitcode::RC rc;
-        *this >> rc;
+        ReadBytes(&m_text[0], n);
 
-        if(rc == 0 && i == length - 1)
+        if(m_pCodepage)
         {
-            // don't push trailing null ('\0')
+            t.t.resize(m_pCodepage->Decode(&t.t[0], &m_text[0], n, nul));
         }
         else
         {
-            t.t.push_back(rc);
+            nul = OcBsDwgCodepage::Widen(&t.t[0], &m_text[0], n);
         }
     }
 
-    for(size_t i = 0; i < t.t.size(); ++i)
-    {
-        // check if NULL is embedded in the string space.
-        // If there is, then the string space may represent
-        // a string array. Will need to investigate and
-        // code appropriately.
-        // For now just debug assert.
-        assert(t.t[i] != L'\0');
-    }
-
-    if(m_convertCodepage)
-    {
-        ConvertToCodepage(t);
-    }
-
+    FinishText(t.t, nul);
     return *this;
 }
 
 OcBsStreamIn & OcBsStreamIn::operator>>(bitcode::TU & tu)
 {
     VLOG_FUNC_NAME;
-    tu.t.clear();
     bitcode::BS length;
     *this >> length;
+    int n = std::max<int>(length.t, 0);
 
-    for(int i = 0; i < length.t; ++i)
-    {
-        bitcode::RS rs;
-        *this >> rs;
-
-        if(rs == 0 && i == length - 1)
-        {
-            // don't push trailing null ('\0')
-        }
-        else
-        {
-            tu.t.push_back(rs);
-        }
-    }
+    m_text.resize(n * 2);
+    tu.t.resize(n);
+    size_t nul = n;
 
-    for(size_t i = 0; i < tu.t.size(); ++i)
+    if(n)
     {
-        // check if NULL is embedded in the string space.
-        // If there is, then the string space may represent
-        // a string array. Will need to investigate and
-        // code appropriately.
-        // For now just debug assert.
-        assert(tu.t[i] != L'\0');
+        ReadBytes(&m_text[0], n * 2);
+        nul = WidenWords(&tu.t[0], &m_text[0], n);
     }
 
+    FinishText(tu.t, nul);
     return *this;
 }
 
@@ -46,6 +46,7 @@
 #pragma once
 #include "OcBsStream.h"
 #include "OcDbObjectId.h"
+#include "OcBsTrace.h"
 
 BEGIN_OCTAVARIUM_NS
 
@@ -53,11 +54,15 @@ class OcBsStreamIn : public OcBsStream
 {
 public:
     OcBsStreamIn(void);
-    explicit OcBsStreamIn(const std::string & filename);
+    explicit OcBsStreamIn(const std::string & filename,
+                          StreamMode streamMode = eFileStream);
+    OcBsStreamIn(const uint8_t * pData, size_t size);
 
     virtual ~OcBsStreamIn(void);
 
-    virtual void Open(const std::string & filename);
+    virtual void Open(const std::string & filename,
+                      StreamMode streamMode = eFileStream);
+    virtual void Open(const uint8_t * pData, size_t size);
 
     virtual bool Good(void) const;
     virtual bool Eof(void) const;
@@ -69,13 +74,25 @@ public:
     }
     virtual OcBsStreamIn & Seek(std::streamoff nPos, int nBit = 0);
     OcBsStreamIn & ReadHandle(OcDbObjectId & objId);
-    OcBsStreamIn & ReadCRC(uint16_t & crc, bool bSkipCrcTracking = true);
-    OcBsStreamIn & ReadRC(bitcode::RC * pRc, size_t size, bool bSkipCrcTracking = false);
-    OcBsStreamIn & ReadRC(std::vector<bitcode::RC> & rc, size_t size, bool bSkipCrcTracking = false);
-    OcBsStreamIn & ReadRC(std::string & rc, size_t size, bool bSkipCrcTracking = false);
+
+    /**
+     *  Reads the next nBits (1 - 64) from the stream, first bit read is
+     *  returned in the most significant position of the result.
+     */
+    uint64_t ReadBits(int nBits);
+    OcBsStreamIn & ReadCRC(uint16_t & crc);
+    OcBsStreamIn & ReadRC(bitcode::RC * pRc, size_t size);
+    OcBsStreamIn & ReadRC(std::vector<bitcode::RC> & rc, size_t size);
+    OcBsStreamIn & ReadRC(std::string & rc, size_t size);
 
     void AdvanceToByteBoundary(void);
 
+    /**
+     *  Moves the read position nBits ahead without reading the data in
+     *  between. Unlike Seek it is not counted as a seek.
+     */
+    void SkipBits(uint64_t nBits);
+
     virtual OcBsStreamIn & operator>>(OcDbObjectId & objId);
     virtual OcBsStreamIn & operator>>(bitcode::B & b);
     virtual OcBsStreamIn & operator>>(bitcode::BB & bb);
@@ -101,120 +118,140 @@ public:
     virtual OcBsStreamIn & operator>>(bitcode::T & t);
     virtual OcBsStreamIn & operator>>(bitcode::TU & tu);
 
+    /**
+     *  Forms of the readers whose encoding depends on the drawing
+     *  version, for decoders templated on the version. The version tests
+     *  fold away in each instantiation. The operators above pick one at
+     *  run time.
+     */
+    template<DWG_VERSION V> OcBsStreamIn & ReadBE(bitcode::BE & be);
+    template<DWG_VERSION V> OcBsStreamIn & ReadBT(bitcode::BT & bt);
+    template<DWG_VERSION V> OcBsStreamIn & ReadCMC(bitcode::CMC & cmc);
+    template<DWG_VERSION V> OcBsStreamIn & ReadTV(bitcode::TV & tv);
+
+private:
+    // Reads size raw bytes. Copies the run in one go when on a byte
+    // boundary, otherwise shift merges them a word at a time.
+    void ReadBytes(uint8_t * pDst, size_t size);
+
+    // raw bytes of the T or TU string being decoded, reused between reads
+    std::vector<uint8_t> m_text;
 };
 
 
-// helper template function to ensure T is dereferenced before
-// calling stream in.
-template<typename BC, typename T>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const T & t)
+template<DWG_VERSION V>
+OcBsStreamIn & OcBsStreamIn::ReadBE(bitcode::BE & be)
 {
-    stream >> (BC&) t;
-    return stream;
-}
+    VLOG_FUNC_NAME;
 
+    if(V >= R2000)
+    {
+        be.t.set(0.0, 0.0, 1.0);
+    }
+    else
+    {
+        bitcode::BD * pbd = (bitcode::BD*)&be;
+        *this >> pbd[0] >> pbd[1] >> pbd[2];
+    }
 
-template<typename BC, typename T>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const T & t, const char * pStr)
-{
-    StreamIn<BC, T>(stream, t);
-    VLOG(4) << pStr << ": " << t;
-    return stream;
+    return *this;
 }
 
-// handle when t is a char and print t as an int
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const int8_t & t, const char * pStr)
+template<DWG_VERSION V>
+OcBsStreamIn & OcBsStreamIn::ReadBT(bitcode::BT & bt)
 {
-    StreamIn<BC>(stream, t);
-    VLOG(4) << pStr << ": " << (int) t;
-    return stream;
-}
+    VLOG_FUNC_NAME;
+    bitcode::B flag(0);
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const bool & t, const char * pStr)
-{
-    StreamIn<BC>(stream, t);
-    VLOG(4) << pStr << ": " << (t == true ? "true" : "false");
-    return stream;
-}
+    if(V >= R2000)
+    {
+        *this >> flag;
+    }
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const byte_t & t, const char * pStr)
-{
-    StreamIn<BC>(stream, t);
-    VLOG(4) << pStr << ": " << (int) t;
-    return stream;
+    if(flag.t)
+    {
+        bt = 0.0;
+    }
+    else
+    {
+        bitcode::BD bd;
+        *this >> bd;
+        bt = bd;
+    }
+
+    return *this;
 }
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const bitcode::CMC & t, const char * pStr)
+template<DWG_VERSION V>
+OcBsStreamIn & OcBsStreamIn::ReadCMC(bitcode::CMC & cmc)
 {
-    StreamIn<BC>(stream, t);
-    VLOG(4) << pStr << ": " << (bitcode::BCCMC&)t;
-    return stream;
+    VLOG_FUNC_NAME;
+    *this >> (bitcode::BS&)cmc.t.index;
+
+    if(V >= R2004)
+    {
+        *this >> (bitcode::BL&)cmc.t.rgb >> (bitcode::RC&)cmc.t.colorByte;
+
+        if(cmc.t.colorByte & 1)
+        {
+            ReadTV<V>((bitcode::TV&)cmc.t.name);
+        }
+
+        if(cmc.t.colorByte & 2)
+        {
+            ReadTV<V>((bitcode::TV&)cmc.t.bookName);
+        }
+    }
+
+    return *this;
 }
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const std::wstring & t, const char * pStr)
+template<DWG_VERSION V>
+OcBsStreamIn & OcBsStreamIn::ReadTV(bitcode::TV & tv)
 {
-    // need to figure out why wstring and wchar_t can not be streamed directly.
-    // If it is streamed directly right now it prints the hex address of
-    // the string.
-    // Prior to adding the OcGePoint2d class this worked fined, and did not
-    // require this template specialization.
-    if(typeid(BC).name() == typeid(bitcode::T).name()
-            || (typeid(BC).name() == typeid(bitcode::TV).name()
-                && stream.Version() <= R2004))
+    VLOG_FUNC_NAME;
+
+    if(V < R2007)
     {
-        //        if(ar.Version() <= R2004) {
-        StreamIn<bitcode::T>(stream, t);
-        VLOG(4) << pStr << ": \"" << WStringToString(t.c_str()).c_str() << "\"";
+        *this >> (bitcode::T&) tv;
     }
     else
     {
-        StreamIn<bitcode::TU>(stream, t);
-        VLOG(4) << pStr << ": U\"" << WStringToString(t.c_str()).c_str() << "\"";
+        *this >> (bitcode::TU&) tv;
     }
 
-    //    StreamIn<BC>(ar, t);
-    //    VLOG(4) << pStr << ": \"" << WStringToString(t.c_str()).c_str() << "\"";
-    return stream;
+    return *this;
 }
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const wchar_t * t, const char * pStr)
-{
-    StreamIn<BC>(stream, t);
-    VLOG(4) << pStr << ": \"" << t << "\"";
-    return stream;
-}
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const double & t, const char * pStr)
+// helper template function to ensure T is dereferenced before
+// calling stream in.
+template<typename BC, typename T>
+OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const T & t)
 {
-    StreamIn<BC>(stream, t);
-    VLOG(4) << std::showpoint << pStr << ": " << t;
+    stream >> (BC&) t;
     return stream;
 }
 
-template<typename BC>
-OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const OcDbObjectId & t, const char * pStr)
+
+// Traced read, used by BS_STREAMIN when OC_TRACE_BITSTREAM is enabled.
+template<typename BC, typename T>
+OcBsStreamIn& StreamIn(OcBsStreamIn & stream, const T & t, const char * pStr)
 {
-    StreamIn<BC>(stream, t);
-    VLOG(4) << std::showpoint << pStr << ": " << t;
+    int64_t bitOffset = stream.BitOffset();
+    StreamIn<BC, T>(stream, t);
+    OcBsTrace::Record(pStr, bitOffset, TraceValue(t));
     return stream;
 }
 
 std::string RC2Hex(const std::vector<bitcode::RC> &bytes);
 
-// Help with dead string stripping for the StreamIn template, without this
-// DSS only occurred with gcc compiler setting of -O3
-#if GOOGLE_STRIP_LOG > 0
-// have compiler strip away STR from code
-#  define BS_STREAMIN(BC, STREAM, T, STR) StreamIn<BC>(STREAM, T, "");
-#else
+// Without tracing the field name never reaches the compiler, so there is
+// nothing left to strip and no per field overhead over a plain read.
+#if OC_TRACE_BITSTREAM
 #  define BS_STREAMIN(BC, STREAM, T, STR) StreamIn<BC>(STREAM, T, #STR);
+#else
+#  define BS_STREAMIN(BC, STREAM, T, STR) StreamIn<BC>(STREAM, T);
 #endif
 
 END_OCTAVARIUM_NS
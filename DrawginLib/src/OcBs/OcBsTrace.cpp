@@ -0,0 +1,97 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include <sstream>
+#include "OcCommon.h"
+#include "OcBsTrace.h"
+
+#if defined(_MSC_VER)
+#  define OC_THREAD_LOCAL __declspec(thread)
+#else
+#  define OC_THREAD_LOCAL __thread
+#endif
+
+BEGIN_OCTAVARIUM_NS
+
+static OC_THREAD_LOCAL OcBsTraceRecord s_traceRing[OcBsTracer<true>::RINGSIZE];
+// total number of records this thread has written
+static OC_THREAD_LOCAL uint32_t s_traceCount;
+
+void OcBsTracer<true>::Record(const char * field, int64_t bitOffset, uint64_t value)
+{
+    OcBsTraceRecord & rec = s_traceRing[s_traceCount++ & (RINGSIZE - 1)];
+    rec.field = field;
+    rec.bitOffset = bitOffset;
+    rec.value = value;
+}
+
+void OcBsTracer<true>::Dump(std::ostream & out)
+{
+    VLOG_FUNC_NAME;
+    uint32_t count = std::min<uint32_t>(s_traceCount, RINGSIZE);
+
+    for(uint32_t i = s_traceCount - count; i != s_traceCount; ++i)
+    {
+        const OcBsTraceRecord & rec = s_traceRing[i & (RINGSIZE - 1)];
+        out << rec.bitOffset / CHAR_BIT << "." << rec.bitOffset % CHAR_BIT
+            << " " << rec.field << " = " << rec.value
+            << " (" << std::hex << std::showbase << rec.value
+            << std::dec << std::noshowbase << ")\n";
+    }
+}
+
+void OcBsTracer<true>::DumpToLog()
+{
+    VLOG_FUNC_NAME;
+    std::ostringstream ss;
+    Dump(ss);
+    LOG(ERROR) << "Last decoded fields:\n" << ss.str();
+}
+
+void OcBsTracer<true>::Clear()
+{
+    VLOG_FUNC_NAME;
+    s_traceCount = 0;
+}
+
+END_OCTAVARIUM_NS
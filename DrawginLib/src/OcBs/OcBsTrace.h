@@ -0,0 +1,145 @@
+/**
+ *	@file
+ *  @brief Defines OcBsTrace
+ *
+ *  Compile time selected tracing of decoded bit stream fields
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include <type_traits>
+#include "OcDbObjectId.h"
+
+// When OC_TRACE_BITSTREAM is 0, BS_STREAMIN compiles to a plain stream read
+// and nothing in this file is referenced. Debug builds trace by default,
+// release builds can opt in with OC_TRACE_BITSTREAM=1.
+#ifndef OC_TRACE_BITSTREAM
+#  ifdef NDEBUG
+#    define OC_TRACE_BITSTREAM 0
+#  else
+#    define OC_TRACE_BITSTREAM 1
+#  endif
+#endif
+
+BEGIN_OCTAVARIUM_NS
+
+struct OcBsTraceRecord
+{
+    const char * field;     // string literal, so the pointer is the id
+    int64_t bitOffset;      // stream position of the first bit of the field
+    uint64_t value;         // see TraceValue
+};
+
+/**
+ *  Records decoded fields into a per thread ring buffer. Only the
+ *  calling thread writes its ring, so recording takes no locks. Records
+ *  are formatted when Dump is called, never while decoding.
+ */
+template<bool bEnabled>
+class OcBsTracer
+{
+public:
+    static void Record(const char * /*field*/, int64_t /*bitOffset*/, uint64_t /*value*/) {}
+    static void Dump(std::ostream & /*out*/) {}
+    static void DumpToLog() {}
+    static void Clear() {}
+};
+
+template<>
+class OcBsTracer<true>
+{
+public:
+    // RINGSIZE should be a power of 2.
+    const static int RINGSIZE = 4096;
+
+    static void Record(const char * field, int64_t bitOffset, uint64_t value);
+
+    /**
+     *  Writes the calling thread's most recent records, oldest first.
+     */
+    static void Dump(std::ostream & out);
+
+    /**
+     *  Dump as an error log message. Called where decoding fails, so the
+     *  log shows the fields leading up to the failure.
+     */
+    static void DumpToLog();
+    static void Clear();
+};
+
+typedef OcBsTracer<OC_TRACE_BITSTREAM != 0> OcBsTrace;
+
+// The value stored for a field. Integers as is, doubles as their bits,
+// strings as their length, handles as the handle. Other types aren't
+// recorded, the field name and offset are enough to find them.
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, uint64_t>::type
+TraceValue(const T & t)
+{
+    return (uint64_t) t;
+}
+
+inline uint64_t TraceValue(const double & t)
+{
+    uint64_t bits;
+    memcpy(&bits, &t, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t TraceValue(const std::wstring & t)
+{
+    return t.size();
+}
+
+inline uint64_t TraceValue(const OcDbObjectId & t)
+{
+    return (uint64_t) t.Handle();
+}
+
+template<typename T>
+typename std::enable_if<std::is_class<T>::value, uint64_t>::type
+TraceValue(const T & /*t*/)
+{
+    return 0;
+}
+
+END_OCTAVARIUM_NS
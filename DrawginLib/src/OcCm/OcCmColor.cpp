@@ -46,6 +46,12 @@
 BEGIN_OCTAVARIUM_NS
 
 OcCmColor::OcCmColor(void)
+    : m_colorIndex(0), m_rgb(0)
+{
+}
+
+OcCmColor::OcCmColor(int16_t colorIndex, int32_t rgb)
+    : m_colorIndex(colorIndex), m_rgb(rgb)
 {
 }
 
@@ -54,10 +60,21 @@ OcCmColor::~OcCmColor(void)
 {
 }
 
+int16_t OcCmColor::ColorIndex(void) const
+{
+    return m_colorIndex;
+}
+
+int32_t OcCmColor::Rgb(void) const
+{
+    return m_rgb;
+}
+
 std::ostream& operator <<(std::ostream& out, const OcCmColor& color)
 {
     //    return LogWString(out, objId.ToString());
-    out << std::hex << std::showbase << "OcCmColor:: Not implemented";
+    out << "index: " << color.m_colorIndex << ", "
+        << "rgb: " << std::hex << std::showbase << color.m_rgb << std::dec;
     return out;
 }
 
@@ -0,0 +1,276 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include "OcCommon.h"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include "OcError.h"
+#include "OcDbDatabase_p.h"
+#include "OcDbBatchLoader.h"
+
+BEGIN_OCTAVARIUM_NS
+
+class OcDbBatchLoaderPrivate
+{
+    DISABLE_COPY(OcDbBatchLoaderPrivate);
+
+public:
+    OcDbBatchLoaderPrivate(int nThreads, uint64_t memoryBudget);
+
+    struct Item
+    {
+        std::string sFilename;
+        const uint8_t * data;
+        size_t len;
+        OcDbDatabase::ReadMode mode;
+    };
+
+    void Run(const OcDbBatchLoader::Callback & callback);
+
+    int m_nThreads;
+    uint64_t m_memoryBudget;
+    std::vector<Item> m_items;
+
+private:
+    void Worker(const OcDbBatchLoader::Callback & callback);
+    void Read(size_t index, uint64_t size, const OcDbBatchLoader::Callback & callback);
+    static uint64_t ItemSize(const Item & item);
+
+    std::mutex m_mutex;
+    std::condition_variable m_budgetFreed;
+    size_t m_next;
+    uint64_t m_bytesInFlight;
+    int m_nInFlight;
+    std::exception_ptr m_exception;
+};
+
+OcDbBatchLoaderPrivate::OcDbBatchLoaderPrivate(int nThreads, uint64_t memoryBudget)
+    : m_nThreads(nThreads), m_memoryBudget(memoryBudget), m_next(0),
+      m_bytesInFlight(0), m_nInFlight(0)
+{
+    VLOG_FUNC_NAME;
+
+    if(m_nThreads <= 0)
+    {
+        m_nThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+}
+
+void OcDbBatchLoaderPrivate::Run(const OcDbBatchLoader::Callback & callback)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "Reading " << m_items.size() << " drawings with "
+            << m_nThreads << " threads";
+
+    m_next = 0;
+    m_bytesInFlight = 0;
+    m_nInFlight = 0;
+    m_exception = nullptr;
+
+    int nWorkers = (int) std::min<size_t>(m_nThreads, m_items.size());
+    std::vector<std::thread> workers;
+    for(int i = 0; i < nWorkers; ++i)
+    {
+        workers.push_back(std::thread(&OcDbBatchLoaderPrivate::Worker, this,
+                                      std::cref(callback)));
+    }
+
+    for(auto & worker : workers)
+    {
+        worker.join();
+    }
+
+    m_items.clear();
+    if(m_exception)
+    {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+void OcDbBatchLoaderPrivate::Worker(const OcDbBatchLoader::Callback & callback)
+{
+    VLOG_FUNC_NAME;
+
+    for(;;)
+    {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(m_next >= m_items.size() || m_exception)
+            {
+                return;
+            }
+            index = m_next++;
+        }
+
+        // outside of the lock, it may have to go to the disk
+        uint64_t size = ItemSize(m_items[index]);
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_budgetFreed.wait(lock, [&]
+            {
+                return m_nInFlight == 0 || m_memoryBudget == 0 ||
+                       m_bytesInFlight + size <= m_memoryBudget;
+            });
+            m_bytesInFlight += size;
+            m_nInFlight++;
+        }
+
+        try
+        {
+            Read(index, size, callback);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_exception)
+            {
+                m_exception = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bytesInFlight -= size;
+            m_nInFlight--;
+        }
+        m_budgetFreed.notify_all();
+    }
+}
+
+void OcDbBatchLoaderPrivate::Read(size_t index, uint64_t size,
+                                  const OcDbBatchLoader::Callback & callback)
+{
+    VLOG_FUNC_NAME;
+    const Item & item = m_items[index];
+
+    // Share the threads with the other drawings in flight. Early in the
+    // batch every thread has a drawing and objects are decoded serially,
+    // toward the end the idle threads go to the drawings still reading.
+    int nDecodeThreads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        nDecodeThreads = std::max(1, m_nThreads / m_nInFlight);
+    }
+
+    std::unique_ptr<OcDbDatabase> pDb(new OcDbDatabase);
+    pDb->SetDecodeThreads(nDecodeThreads);
+
+    OcApp::ErrorStatus es;
+    if(item.data)
+    {
+        es = pDb->ReadDwg(item.data, item.len, item.mode);
+    }
+    else
+    {
+        es = pDb->ReadDwg(item.sFilename, item.mode);
+    }
+
+    VLOG(4) << "Drawing " << index << " (" << size << " bytes) read, status " << es;
+    callback(index, es, pDb);
+}
+
+uint64_t OcDbBatchLoaderPrivate::ItemSize(const Item & item)
+{
+    VLOG_FUNC_NAME;
+
+    if(item.data)
+    {
+        return item.len;
+    }
+
+    // a file that can't be opened counts as empty, ReadDwg reports it
+    std::ifstream fs(item.sFilename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    return fs ? (uint64_t) fs.tellg() : 0;
+}
+
+OcDbBatchLoader::OcDbBatchLoader(int nThreads, uint64_t memoryBudget)
+    : m_pImpl(new OcDbBatchLoaderPrivate(nThreads, memoryBudget))
+{
+    VLOG_FUNC_NAME;
+}
+
+OcDbBatchLoader::~OcDbBatchLoader(void)
+{
+    VLOG_FUNC_NAME;
+}
+
+size_t OcDbBatchLoader::Add(const std::string & sFilename, OcDbDatabase::ReadMode mode)
+{
+    VLOG_FUNC_NAME;
+    OcDbBatchLoaderPrivate::Item item;
+    item.sFilename = sFilename;
+    item.data = nullptr;
+    item.len = 0;
+    item.mode = mode;
+    m_pImpl->m_items.push_back(item);
+    return m_pImpl->m_items.size() - 1;
+}
+
+size_t OcDbBatchLoader::Add(const uint8_t * data, size_t len, OcDbDatabase::ReadMode mode)
+{
+    VLOG_FUNC_NAME;
+    OcDbBatchLoaderPrivate::Item item;
+    item.data = data;
+    item.len = len;
+    item.mode = mode;
+    m_pImpl->m_items.push_back(item);
+    return m_pImpl->m_items.size() - 1;
+}
+
+size_t OcDbBatchLoader::Size(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_items.size();
+}
+
+void OcDbBatchLoader::Run(const Callback & callback)
+{
+    VLOG_FUNC_NAME;
+    m_pImpl->Run(callback);
+}
+
+END_OCTAVARIUM_NS
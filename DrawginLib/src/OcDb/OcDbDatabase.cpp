@@ -44,6 +44,7 @@
 #include "OcError.h"
 #include "OcDbDatabase_p.h"
 #include "OcDbDatabase.h"
+#include "..\OcBs\OcBsTrace.h"
 
 BEGIN_OCTAVARIUM_NS
 
@@ -77,11 +78,12 @@ const OcDbDatabasePrivate * OcDbDatabase::d_func() const
     return m_pImpl.get();
 }
 
-OcApp::ErrorStatus OcDbDatabase::ReadDwg(const std::string & sFilename)
+OcApp::ErrorStatus OcDbDatabase::ReadDwg(const std::string & sFilename,
+                                         ReadMode mode /*= eReadAll*/)
 {
     VLOG_FUNC_NAME;
     VLOG(4) << "OcDbDatabase::ReadDwg entered";
-    OcApp::ErrorStatus es = m_pImpl->ReadDwg(sFilename);
+    OcApp::ErrorStatus es = m_pImpl->ReadDwg(sFilename, mode);
     if(es == OcApp::eOk)
     {
         LOG(INFO) << "Reading drawing file successful";
@@ -93,4 +95,65 @@ OcApp::ErrorStatus OcDbDatabase::ReadDwg(const std::string & sFilename)
     return es;
 }
 
+OcApp::ErrorStatus OcDbDatabase::ReadDwg(const uint8_t * data, size_t len,
+                                         ReadMode mode /*= eReadAll*/)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "OcDbDatabase::ReadDwg entered";
+    OcApp::ErrorStatus es = m_pImpl->ReadDwg(data, len, mode);
+    if(es == OcApp::eOk)
+    {
+        LOG(INFO) << "Reading drawing file successful";
+    }
+    else
+    {
+        LOG(ERROR) << "Reading drawing file failed";
+    }
+    return es;
+}
+
+OcApp::ErrorStatus OcDbDatabase::Probe(const std::string & sFilename, OcDbProbeInfo & info,
+                                       bool bHeaderVars /*= true*/)
+{
+    VLOG_FUNC_NAME;
+    return OcDbDatabasePrivate::Probe(sFilename, info, bHeaderVars);
+}
+
+OcApp::ErrorStatus OcDbDatabase::Probe(const uint8_t * data, size_t len, OcDbProbeInfo & info,
+                                       bool bHeaderVars /*= true*/)
+{
+    VLOG_FUNC_NAME;
+    return OcDbDatabasePrivate::Probe(data, len, info, bHeaderVars);
+}
+
+OcApp::ErrorStatus OcDbDatabase::ObjectType(const OcDbObjectId & objId, uint16_t & type)
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->ObjectType(objId, type);
+}
+
+void OcDbDatabase::DumpTrace(std::ostream & out)
+{
+    VLOG_FUNC_NAME;
+    OcBsTrace::Dump(out);
+}
+
+const OcDbReadStats & OcDbDatabase::ReadStats() const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->ReadStats();
+}
+
+void OcDbDatabase::SetDecodeThreads(int nThreads)
+{
+    VLOG_FUNC_NAME;
+    m_pImpl->SetDecodeThreads(nThreads);
+}
+
+void OcDbDatabase::SetFileAccess(FileAccess access)
+{
+    VLOG_FUNC_NAME;
+    m_pImpl->SetFileAccess(access);
+}
+
 END_OCTAVARIUM_NS
\ No newline at end of file
@@ -41,28 +41,121 @@
 ****************************************************************************/
 
 #include "OcCommon.h"
+#include <algorithm>
+#include <chrono>
 #include "OcError.h"
 #include "OcDbDatabase_p.h"
 #include "..\OcBs\OcBsStreamIn.h"
 #include "..\OcBs\OcBsDwgFileHeader.h"
+#include "..\OcBs\OcBsDwgVersion.h"
 #include "..\OcBs\OcBsDwgPreviewImage.h"
 #include "..\OcBs\OcBsDatabaseHeaderVars.h"
 #include "..\OcBs\OcBsDwgClasses.h"
 #include "..\OcBs\OcBsDwgObjectMap.h"
 #include "..\OcBs\OcBsDwgSecondFileHeader.h"
 #include "..\OcBs\OcBsDwgDataSection.h"
+#include "..\OcBs\OcBsReadahead.h"
 
 BEGIN_OCTAVARIUM_NS
 
+namespace
+{
+const std::streamsize readaheadMinFileSize = 1024 * 1024;
+const std::streamsize readaheadLastObjectSize = 64 * 1024;
+
+// Adds the time and stream activity of its scope to one phase of
+// OcDbReadStats.
+class PhaseTimer
+{
+    DISABLE_COPY(PhaseTimer);
+    typedef std::chrono::high_resolution_clock Clock;
+
+public:
+    PhaseTimer(OcDbReadStats & stats, OcDbReadStats::Phase phase, const OcBsStreamIn & in)
+        : m_stats(stats.phases[phase]), m_in(in), m_start(Clock::now()),
+          m_counters(in.Counters())
+    {
+    }
+
+    ~PhaseTimer()
+    {
+        const OcBsStream::IoCounters & now = m_in.Counters();
+        m_stats.seconds += std::chrono::duration<double>(Clock::now() - m_start).count();
+        m_stats.bytes += (now.bitsRead - m_counters.bitsRead) / 8;
+        m_stats.seeks += now.seeks - m_counters.seeks;
+        m_stats.refills += now.refills - m_counters.refills;
+        m_stats.crcBytes += now.crcBytes - m_counters.crcBytes;
+    }
+
+private:
+    OcDbReadStats::PhaseStats & m_stats;
+    const OcBsStreamIn & m_in;
+    Clock::time_point m_start;
+    OcBsStream::IoCounters m_counters;
+};
+
+// Waits for the crcs of the sections ReadDwg has read on every way out of
+// it, so no crc task is still reading the stream when the caller releases
+// it. Declare it after the sections it checks.
+class SectionCRCs
+{
+    DISABLE_COPY(SectionCRCs);
+
+public:
+    SectionCRCs() : m_pHdrVars(nullptr), m_pClasses(nullptr)
+    {
+    }
+
+    ~SectionCRCs()
+    {
+        Check();
+    }
+
+    void Add(OcBsDatabaseHeaderVars & hdrVars)
+    {
+        m_pHdrVars = &hdrVars;
+    }
+
+    void Add(OcBsDwgClasses & classes)
+    {
+        m_pClasses = &classes;
+    }
+
+    // A mismatch is logged and the drawing is still read, as it was when
+    // the sections checked their crc inline.
+    void Check()
+    {
+        if(m_pHdrVars)
+        {
+            m_pHdrVars->CheckCRC();
+            m_pHdrVars = nullptr;
+        }
+
+        if(m_pClasses)
+        {
+            m_pClasses->CheckCRC();
+            m_pClasses = nullptr;
+        }
+    }
+
+private:
+    OcBsDatabaseHeaderVars * m_pHdrVars;
+    OcBsDwgClasses * m_pClasses;
+};
+}
+
 OcDbDatabasePrivate::OcDbDatabasePrivate(void)
+    : m_nDecodeThreads(0), m_fileAccess(OcDbDatabase::eMapFile)
 {
     VLOG_FUNC_NAME;
+    ClearHeaderVars();
 }
 
 OcDbDatabasePrivate::OcDbDatabasePrivate(OcDbDatabase * q)
-    : OcObjectPrivate(q)
+    : OcObjectPrivate(q), m_nDecodeThreads(0), m_fileAccess(OcDbDatabase::eMapFile)
 {
     VLOG_FUNC_NAME;
+    ClearHeaderVars();
 }
 
 
@@ -72,37 +165,264 @@ OcDbDatabasePrivate::~OcDbDatabasePrivate(void)
     m_qPtr = nullptr;
 }
 
-OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(const std::string & sFilename)
+OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(const std::string & sFilename,
+                                                OcDbDatabase::ReadMode mode)
 {
     VLOG_FUNC_NAME;
     VLOG(4) << "OcDbDatabasePrivate::ReadDwg entered";
 
-    OcBsStreamIn in;
-    in.Open(sFilename);
+    // Decode directly from a memory mapped view of the file when
+    // possible, otherwise fall back to buffered file reads.
+    std::unique_ptr<OcBsStreamIn> pIn(new OcBsStreamIn);
+    bool bMapped = false;
+    if(m_fileAccess == OcDbDatabase::eMapFile)
+    {
+        pIn->Open(sFilename, OcBsStream::eMemoryMapped);
+        bMapped = !!*pIn;
+        if(!bMapped)
+        {
+            VLOG(4) << "Memory mapping failed, reading through file stream";
+            pIn->Close();
+        }
+    }
+
+    if(!bMapped)
+    {
+        pIn->Open(sFilename);
+    }
+
+    if(!*pIn)
+    {
+        return OcApp::eOpeningFile;
+    }
+
+    return ReadDwg(pIn, mode);
+}
+
+OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(const uint8_t * data, size_t len,
+                                                OcDbDatabase::ReadMode mode)
+{
+    VLOG_FUNC_NAME;
+    VLOG(4) << "OcDbDatabasePrivate::ReadDwg(data, len) entered";
+
+    std::unique_ptr<OcBsStreamIn> pIn(new OcBsStreamIn(data, len));
+
+    if(!*pIn)
+    {
+        return OcApp::eOpeningFile;
+    }
+
+    return ReadDwg(pIn, mode);
+}
+
+OcApp::ErrorStatus OcDbDatabasePrivate::Probe(const std::string & sFilename,
+                                              OcDbProbeInfo & info, bool bHeaderVars)
+{
+    VLOG_FUNC_NAME;
+    info.Clear();
+
+    // Buffered reads rather than a mapping, only the start of the file
+    // is needed.
+    OcBsStreamIn in(sFilename);
     if(!in)
     {
         return OcApp::eOpeningFile;
     }
 
+    return Probe(in, info, bHeaderVars);
+}
+
+OcApp::ErrorStatus OcDbDatabasePrivate::Probe(const uint8_t * data, size_t len,
+                                              OcDbProbeInfo & info, bool bHeaderVars)
+{
+    VLOG_FUNC_NAME;
+    info.Clear();
+
+    OcBsStreamIn in(data, len);
+    if(!in)
+    {
+        return OcApp::eOpeningFile;
+    }
+
+    return Probe(in, info, bHeaderVars);
+}
+
+OcApp::ErrorStatus OcDbDatabasePrivate::Probe(OcBsStreamIn & in, OcDbProbeInfo & info,
+                                              bool bHeaderVars)
+{
+    VLOG_FUNC_NAME;
+    OcBsDwgFileHeader dwgHdr;
+    OcApp::ErrorStatus es = dwgHdr.ReadDwg(in);
+    if(es != OcApp::eOk)
+    {
+        LOG(ERROR) << "Error processing drawing file header";
+        return es;
+    }
+
+    info.version = OcBsDwgVersion::GetVersionId(dwgHdr.DwgVersion());
+    info.maintenanceVersion = dwgHdr.MaintenanceVersion();
+    info.codePage = dwgHdr.CodePage();
+    for(int i = 0; i < dwgHdr.NumSectionRecords(); ++i)
+    {
+        OcDbSectionLocator locator;
+        locator.recordNumber = dwgHdr.Record(i).recordNumber;
+        locator.seeker = dwgHdr.Record(i).seeker;
+        locator.size = dwgHdr.Record(i).size;
+        info.sections.push_back(locator);
+    }
+
+    if(!bHeaderVars || !dwgHdr.IsR13c3OrHigher())
+    {
+        return OcApp::eOk;
+    }
+
+    // Section locator record 0 is the header variables, skip over the
+    // preview image to get there. Only the probed variables are decoded,
+    // straight into info, the others are stepped over. No database is
+    // needed.
+    in.Seek(dwgHdr.Record(0).seeker);
+    OcDbDatabasePrivate * pDb = nullptr;
+    OcBsDatabaseHeaderVars hdrVars;
+    hdrVars.Select("extmin", info.extmin);
+    hdrVars.Select("extmax", info.extmax);
+    hdrVars.Select("insunits", info.insunits);
+    hdrVars.Select("tdupdate_day", info.tdupdateDay);
+    hdrVars.Select("tdupdate_ms", info.tdupdateMs);
+    es = hdrVars.ReadDwg(in, pDb);
+    if(es != OcApp::eOk)
+    {
+        LOG(ERROR) << "Error processing drawing header variables";
+        return es;
+    }
+
+    info.hasHeaderVars = true;
+    return OcApp::eOk;
+}
+
+OcApp::ErrorStatus OcDbDatabasePrivate::ObjectType(const OcDbObjectId & objId, uint16_t & type)
+{
+    VLOG_FUNC_NAME;
+
+    if(!m_pObjMap || !m_pClasses)
+    {
+        return OcApp::eNotInDatabase;
+    }
+
+    OcBsDwgObjectMap::ObjectHeader obj;
+    OcApp::ErrorStatus es = m_pObjMap->Object(m_pStream.get(), *m_pClasses, objId, obj);
+
+    if(es == OcApp::eOk)
+    {
+        type = obj.type;
+    }
+
+    return es;
+}
+
+const OcDbReadStats & OcDbDatabasePrivate::ReadStats() const
+{
+    VLOG_FUNC_NAME;
+    return m_readStats;
+}
+
+void OcDbDatabasePrivate::SetDecodeThreads(int nThreads)
+{
+    VLOG_FUNC_NAME;
+    m_nDecodeThreads = nThreads;
+}
+
+void OcDbDatabasePrivate::SetFileAccess(OcDbDatabase::FileAccess access)
+{
+    VLOG_FUNC_NAME;
+    m_fileAccess = access;
+}
+
+OcDbStringPool & OcDbDatabasePrivate::Strings()
+{
+    VLOG_FUNC_NAME;
+    return m_strings;
+}
+
+void OcDbDatabasePrivate::ClearHeaderVars(void)
+{
+    VLOG_FUNC_NAME;
+    m_flags.reset();
+    for(int i = 0; i < numHeaderTexts; ++i)
+    {
+        m_text[i] = OcDbStringPool::emptyId;
+    }
+    std::fill(m_handles, m_handles + numHeaderHandles, 0);
+    std::fill(m_colors, m_colors + numHeaderColors, 0);
+}
+
+OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(std::unique_ptr<OcBsStreamIn> & pIn,
+                                                OcDbDatabase::ReadMode mode)
+{
+    VLOG_FUNC_NAME;
+    m_pStream.reset();
+    m_pClasses.reset();
+    m_pObjMap.reset();
+    OcBsTrace::Clear();
+    m_strings.Clear();
+    ClearHeaderVars();
+    m_readStats.Clear();
+
+    OcBsStreamIn & in = *pIn;
+
+    // eReadAll sweeps the file front to back, sections then objects in
+    // file offset order. eReadLazy decodes objects as they are asked for.
+    in.Advise(mode == OcDbDatabase::eReadLazy ? OcBsMappedFile::eRandom
+                                              : OcBsMappedFile::eSequential);
+
     OcBsDwgFileHeader dwgHdr;
     OcApp::ErrorStatus es;
-    es = dwgHdr.ReadDwg(in);
+    {
+        PhaseTimer timer(m_readStats, OcDbReadStats::eFileHeader, in);
+        es = dwgHdr.ReadDwg(in);
+    }
     if(es != OcApp::eOk)
     {
         LOG(ERROR) << "Error processing drawing file header";
+        OcBsTrace::DumpToLog();
         return es;
     }
 
+    // Small drawings are read before a thread could get ahead of the
+    // decoder, only bother for larger ones. Declared after in, so it is
+    // stopped before the stream can go away.
+    OcBsReadahead readahead;
+    const bool bReadahead = in.FileLength() >= readaheadMinFileSize;
+    if(bReadahead)
+    {
+        for(int i = 0; i < dwgHdr.NumSectionRecords(); ++i)
+        {
+            // locator records come straight from the file, skip ones
+            // that cannot describe a section.
+            const OcBsDwgFileHeaderSection & record = dwgHdr.Record(i);
+            if(record.seeker < 0 || record.size <= 0)
+            {
+                continue;
+            }
+            readahead.Add(record.seeker,
+                          (std::streamoff) record.seeker + record.size);
+        }
+        readahead.Start(in);
+    }
+
     if(dwgHdr.IsR13c3OrHigher())
     {
         // file position should match offset value in the IMAGE SEEKER
         CHECK(dwgHdr.ImageSeeker() == in.FilePosition())
                 << "IMAGE SEEKER offset does not match current file position";
         OcBsDwgPreviewImage imgData;
-        es = imgData.ReadDwg(in);
+        {
+            PhaseTimer timer(m_readStats, OcDbReadStats::ePreviewImage, in);
+            es = imgData.ReadDwg(in);
+        }
         if(es != OcApp::eOk)
         {
             LOG(ERROR) << "Error processing image data";
+            OcBsTrace::DumpToLog();
             return es;
         }
 
@@ -113,10 +433,16 @@ OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(const std::string & sFilename)
 
         OcDbDatabasePrivate * pThis = this;
         OcBsDatabaseHeaderVars hdrVars;
-        es = hdrVars.ReadDwg(in, pThis);
+        SectionCRCs sectionCRCs;
+        sectionCRCs.Add(hdrVars);
+        {
+            PhaseTimer timer(m_readStats, OcDbReadStats::eHeaderVars, in);
+            es = hdrVars.ReadDwg(in, pThis);
+        }
         if(es != OcApp::eOk)
         {
             LOG(ERROR) << "Error processing drawing header variables";
+            OcBsTrace::DumpToLog();
             return es;
         }
 
@@ -125,11 +451,17 @@ OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(const std::string & sFilename)
         CHECK(dwgHdr.Record(1).seeker == in.FilePosition())
                 << "Section locator record 1 offset does not match current file position";
 
-        OcBsDwgClasses dwgClasses;
-        es = dwgClasses.ReadDwg(in);
+        m_pClasses.reset(new OcBsDwgClasses);
+        OcBsDwgClasses & dwgClasses = *m_pClasses;
+        sectionCRCs.Add(dwgClasses);
+        {
+            PhaseTimer timer(m_readStats, OcDbReadStats::eClasses, in);
+            es = dwgClasses.ReadDwg(in, m_strings);
+        }
         if(es != OcApp::eOk)
         {
             LOG(ERROR) << "Error processing classes section";
+            OcBsTrace::DumpToLog();
             return es;
         }
 
@@ -151,42 +483,90 @@ OcApp::ErrorStatus OcDbDatabasePrivate::ReadDwg(const std::string & sFilename)
         // Read the Object Map portion from the file. When
         // done, OcDfDwgObjectMap will have a collection
         // that tells where in the dwg file objects are located.
-        OcBsDwgObjectMap dwgObjMap(dwgHdr.Record(2).seeker,
-                                   dwgHdr.Record(2).size);
-        es = dwgObjMap.ReadDwg(in);
+        m_pObjMap.reset(new OcBsDwgObjectMap(dwgHdr.Record(2).seeker,
+                                             dwgHdr.Record(2).size));
+        OcBsDwgObjectMap & dwgObjMap = *m_pObjMap;
+        {
+            PhaseTimer timer(m_readStats, OcDbReadStats::eObjectMap, in);
+            es = dwgObjMap.ReadDwg(in);
+        }
         if(es != OcApp::eOk)
         {
             LOG(ERROR) << "Error processing object map section";
+            OcBsTrace::DumpToLog();
             return es;
         }
 
+        if(bReadahead && mode != OcDbDatabase::eReadLazy)
+        {
+            // Objects are decoded in file offset order, queue them the
+            // same way. The size of the last object isn't known until it
+            // is decoded, assume it is not too large.
+            std::vector<int32_t> offsets = dwgObjMap.FileOffsets();
+            if(!offsets.empty())
+            {
+                readahead.Add(offsets.front(), offsets.back() + readaheadLastObjectSize);
+            }
+        }
+
         if(in.Version() == R13 || in.Version() == R14)
         {
             // Read the second file header section. Note, this sections is
             // located immediately after the OcDfDgObjectMap
             OcBsDwgSecondFileHeader dwgSecondHeader;
+            PhaseTimer timer(m_readStats, OcDbReadStats::eSecondFileHeader, in);
             es = dwgSecondHeader.ReadDwg(in);
         }
 
         OcBsDwgDataSection dwgDataSection(dwgHdr.Record(4).seeker, dwgHdr.Record(4).size);
-        es = dwgDataSection.ReadDwg(in);
+        {
+            PhaseTimer timer(m_readStats, OcDbReadStats::eDataSection, in);
+            es = dwgDataSection.ReadDwg(in);
+        }
         if(es != OcApp::eOk)
         {
             LOG(ERROR) << "Error processing data section";
+            OcBsTrace::DumpToLog();
             return es;
         }
         // Add code to read the Spec section 20, AcDb::Template.
         //
         // Add code to read the Spec section 21, Data section AcDb::Handles(object map)
         //
+        if(mode == OcDbDatabase::eReadLazy)
+        {
+            // objects are decoded on first access, keep the file open
+            sectionCRCs.Check();
+            m_pStream = std::move(pIn);
+            return OcApp::eOk;
+        }
+
         // Decode all of the objects that are in the object map
         // collection.
-        es = dwgObjMap.DecodeObjects(in, dwgClasses);
+        {
+            PhaseTimer timer(m_readStats, OcDbReadStats::eObjects, in);
+            es = dwgObjMap.DecodeObjects(in, dwgClasses, m_nDecodeThreads);
+        }
         if(es != OcApp::eOk)
         {
             LOG(ERROR) << "Error processing objects";
             return es;
         }
+
+        // The section crcs have been calculating while the sections
+        // after them were decoded.
+        sectionCRCs.Check();
+
+        std::vector<OcDbObjectTypeStats> & types = m_readStats.objectTypes;
+        for(auto & obj : dwgObjMap.Objects())
+        {
+            if(obj.type >= types.size())
+            {
+                types.resize(obj.type + 1);
+            }
+            types[obj.type].count++;
+            types[obj.type].bytes += obj.size;
+        }
     }
 
     return OcApp::eOk;
@@ -51,6 +51,9 @@
 #include "OcCmColor.h"
 #include "OcGePoint2D.h"
 #include "OcGePoint3D.h"
+#include "OcDbStringPool.h"
+
+#include <bitset>
 
 #include "templates\accessors.h"
 
@@ -58,29 +61,57 @@
 BEGIN_OCTAVARIUM_NS
 
 class OcDbDatabasePrivate;
+class OcBsStreamIn;
+class OcBsDwgClasses;
+class OcBsDwgObjectMap;
 
-EXPIMP_TEMPLATE template class DRAWGIN_API accessors<bool>;
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<byte_t>;
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<double>;
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<int16_t>;
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<int32_t>;
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<uint16_t>;
 
-EXPIMP_TEMPLATE template class DRAWGIN_API accessors<OcCmColor>;
-EXPIMP_TEMPLATE template class DRAWGIN_API accessors<OcDbHardOwnershipId>;
-EXPIMP_TEMPLATE template class DRAWGIN_API accessors<OcDbObjectId>;
-
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<OcGePoint2D>;
 EXPIMP_TEMPLATE template class DRAWGIN_API accessors<OcGePoint3D>;
 
 EXPIMP_TEMPLATE template class DRAWGIN_API std::allocator<wchar_t>;
 EXPIMP_TEMPLATE template class DRAWGIN_API std::basic_string<wchar_t, std::char_traits<wchar_t>, std::allocator<wchar_t> >;
-EXPIMP_TEMPLATE template class DRAWGIN_API accessors<std::wstring>;
 
 
 
 
 
+// Header variables that would be heavy as accessors<> members are kept
+// packed in OcDbDatabasePrivate: flags in a bitset, text as ids into the
+// database's string pool, handles as bare 64 bit values and colors as
+// the index in the low 16 bits and rgb above it. The macros
+// give each one the same getter / setter pair accessors<> provides.
+#define OC_DB_FLAG(NAME) \
+    bool NAME() const { return m_flags[eFlag_##NAME]; } \
+    void NAME(bool b) { m_flags[eFlag_##NAME] = b; }
+
+#define OC_DB_TEXT(NAME) \
+    const std::wstring & NAME() const { return m_strings.String(m_text[eText_##NAME]); } \
+    void NAME(const std::wstring & str) { m_text[eText_##NAME] = m_strings.Intern(str); }
+
+#define OC_DB_HANDLE_AS(ID_TYPE, NAME) \
+    ID_TYPE NAME() const { ID_TYPE id; id.Handle(m_handles[eHandle_##NAME]); return id; } \
+    void NAME(const ID_TYPE & id) { m_handles[eHandle_##NAME] = id.Handle(); }
+#define OC_DB_HANDLE(NAME) OC_DB_HANDLE_AS(OcDbObjectId, NAME)
+#define OC_DB_HARD_HANDLE(NAME) OC_DB_HANDLE_AS(OcDbHardOwnershipId, NAME)
+
+#define OC_DB_COLOR(NAME) \
+    OcCmColor NAME() const \
+    { \
+        return OcCmColor((int16_t) (m_colors[eColor_##NAME] & 0xffff), \
+                         (int32_t) (m_colors[eColor_##NAME] >> 16)); \
+    } \
+    void NAME(const OcCmColor & color) \
+    { \
+        m_colors[eColor_##NAME] = ((uint64_t) (uint32_t) color.Rgb() << 16) | \
+                                  (uint16_t) color.ColorIndex(); \
+    }
+
 class OcObjectPrivate;
 
 class DRAWGIN_API OcDbDatabasePrivate : public OcObjectPrivate
@@ -92,7 +123,24 @@ public:
     OcDbDatabasePrivate(OcDbDatabase * q);
     virtual ~OcDbDatabasePrivate(void);
 
-    OcApp::ErrorStatus ReadDwg(const std::string & sFilename);
+    OcApp::ErrorStatus ReadDwg(const std::string & sFilename,
+                               OcDbDatabase::ReadMode mode);
+    OcApp::ErrorStatus ReadDwg(const uint8_t * data, size_t len,
+                               OcDbDatabase::ReadMode mode);
+    static OcApp::ErrorStatus Probe(const std::string & sFilename, OcDbProbeInfo & info,
+                                    bool bHeaderVars);
+    static OcApp::ErrorStatus Probe(const uint8_t * data, size_t len, OcDbProbeInfo & info,
+                                    bool bHeaderVars);
+    OcApp::ErrorStatus ObjectType(const OcDbObjectId & objId, uint16_t & type);
+    const OcDbReadStats & ReadStats() const;
+    void SetDecodeThreads(int nThreads);
+    void SetFileAccess(OcDbDatabase::FileAccess access);
+
+    /**
+     *  Pool for names and other text that repeats across the objects of
+     *  the drawing. Cleared when a drawing is read.
+     */
+    OcDbStringPool & Strings();
 
     //OcDbDatabase * q_ptr;
 
@@ -116,10 +164,10 @@ public:
     accessors<double> unknown2;
     accessors<double> unknown3;
     accessors<double> unknown4;
-    accessors<std::wstring> unknown5;
-    accessors<std::wstring> unknown6;
-    accessors<std::wstring> unknown7;
-    accessors<std::wstring> unknown8;
+    OC_DB_TEXT(unknown5);
+    OC_DB_TEXT(unknown6);
+    OC_DB_TEXT(unknown7);
+    OC_DB_TEXT(unknown8);
     accessors<int32_t> unknown9;
     accessors<int32_t> unknown10;
     // R13 - R14
@@ -128,67 +176,67 @@ public:
     accessors<int16_t> unknown11;
     // Pre-2004
     /*-------------------- Pre-2004 ------------------*/
-    accessors<OcDbHardOwnershipId> currentVpId;
+    OC_DB_HARD_HANDLE(currentVpId);
 
 
     // common
     /*-------------------- Common --------------------*/
-    accessors<bool> dimaso;
-    accessors<bool> dimsho;
+    OC_DB_FLAG(dimaso);
+    OC_DB_FLAG(dimsho);
     // R13 - R14
     /*------------------- R13 - R14 ------------------*/
-    accessors<bool> dimsav;
+    OC_DB_FLAG(dimsav);
     // common
     /*-------------------- Common --------------------*/
-    accessors<bool> plinegen;
-    accessors<bool> orthomode;
-    accessors<bool> regenmode;
-    accessors<bool> fillmode;
-    accessors<bool> qtextmode;
-    accessors<bool> psltscale;
-    accessors<bool> limcheck;
+    OC_DB_FLAG(plinegen);
+    OC_DB_FLAG(orthomode);
+    OC_DB_FLAG(regenmode);
+    OC_DB_FLAG(fillmode);
+    OC_DB_FLAG(qtextmode);
+    OC_DB_FLAG(psltscale);
+    OC_DB_FLAG(limcheck);
     // R13 - R14
     /*------------------- R13 - R14 ------------------*/
-    accessors<bool> blipmode;
+    OC_DB_FLAG(blipmode);
 
     // R2004+
     /*-------------------- R2004+ --------------------*/
-    accessors<bool> undocumented;
+    OC_DB_FLAG(undocumented);
 
     // common
     /*-------------------- Common --------------------*/
-    accessors<bool> usertimer;
-    accessors<bool> skpoly;
-    accessors<bool> angdir;
-    accessors<bool> splframe;
+    OC_DB_FLAG(usertimer);
+    OC_DB_FLAG(skpoly);
+    OC_DB_FLAG(angdir);
+    OC_DB_FLAG(splframe);
     // R13 - R14
     /*------------------- R13 - R14 ------------------*/
-    accessors<bool> attreq;
-    accessors<bool> attdia;
+    OC_DB_FLAG(attreq);
+    OC_DB_FLAG(attdia);
 
     // common
     /*-------------------- Common --------------------*/
-    accessors<bool> mirrtext;
-    accessors<bool> worldview;
+    OC_DB_FLAG(mirrtext);
+    OC_DB_FLAG(worldview);
 
     // R13 - R14
     /*------------------- R13 - R14 ------------------*/
-    accessors<bool> wireframe;
+    OC_DB_FLAG(wireframe);
 
     // common
     /*-------------------- Common --------------------*/
-    accessors<bool> tilemode;
-    accessors<bool> plimcheck;
-    accessors<bool> visretain;
+    OC_DB_FLAG(tilemode);
+    OC_DB_FLAG(plimcheck);
+    OC_DB_FLAG(visretain);
 
     // R13 - R14
     /*------------------- R13 - R14 ------------------*/
-    accessors<bool> delobj;
+    OC_DB_FLAG(delobj);
 
     // common
     /*-------------------- Common --------------------*/
-    accessors<bool> dispsilh;
-    accessors<bool> pellipse;
+    OC_DB_FLAG(dispsilh);
+    OC_DB_FLAG(pellipse);
     accessors<int16_t> saveimages; // proxygraphics R14 - R2000)
 
     // R13 - R14
@@ -272,7 +320,7 @@ public:
     accessors<double> facetres;
     accessors<double> cmlscale;
     accessors<double> celtscale;
-    accessors<std::wstring> menuname;
+    OC_DB_TEXT(menuname);
     accessors<int32_t> tdcreate_day;
     accessors<int32_t> tdcreate_ms;
     accessors<int32_t> tdupdate_day;
@@ -290,20 +338,20 @@ public:
     accessors<int32_t> tdindwg_ms;
     accessors<int32_t> tdusrtimer_days;
     accessors<int32_t> tdusrtimer_ms;
-    accessors<OcCmColor> cecolor;
-    accessors<OcDbObjectId> handseed;
-    accessors<OcDbObjectId> clayer;
-    accessors<OcDbObjectId> textstyle;
-    accessors<OcDbObjectId> celtype;
+    OC_DB_COLOR(cecolor);
+    OC_DB_HANDLE(handseed);
+    OC_DB_HANDLE(clayer);
+    OC_DB_HANDLE(textstyle);
+    OC_DB_HANDLE(celtype);
 
     // R2007+
     /*-------------------- R2007+ --------------------*/
-    accessors<OcDbObjectId> cmaterial;
+    OC_DB_HANDLE(cmaterial);
 
     // common
     /*-------------------- Common --------------------*/
-    accessors<OcDbObjectId> dimstyle;
-    accessors<OcDbObjectId> cmlstyle;
+    OC_DB_HANDLE(dimstyle);
+    OC_DB_HANDLE(cmlstyle);
 
     // R2000+
     /*-------------------- R2000+ --------------------*/
@@ -329,14 +377,14 @@ public:
     accessors<OcGePoint3D> pucsxdir;
 //    accessors<double> ucsydir[3];
     accessors<OcGePoint3D> pucsydir;
-    accessors<OcDbObjectId> pucsname;
+    OC_DB_HANDLE(pucsname);
 
 
     // R2000+
     /*-------------------- R2000+ --------------------*/
-    accessors<OcDbObjectId> pucsbase;
+    OC_DB_HANDLE(pucsbase);
     accessors<int16_t> pucsorthoview;
-    accessors<OcDbObjectId> pucsorthoref;
+    OC_DB_HANDLE(pucsorthoref);
     accessors<OcGePoint3D> pucsorgtop;
     accessors<OcGePoint3D> pucsorgbottom;
     accessors<OcGePoint3D> pucsorgleft;
@@ -364,45 +412,45 @@ public:
     accessors<OcGePoint3D> ucsxdir;
     //    accessors<double> ucsydir[3];
     accessors<OcGePoint3D> ucsydir;
-    accessors<OcDbObjectId> ucsname;
+    OC_DB_HANDLE(ucsname);
 
     // R2000+
     /*-------------------- R2000+ --------------------*/
-    accessors<OcDbObjectId> ucsbase;
+    OC_DB_HANDLE(ucsbase);
     accessors<int16_t> ucsorthoview;
-    accessors<OcDbObjectId> ucsorthoref;
+    OC_DB_HANDLE(ucsorthoref);
     accessors<OcGePoint3D> ucsorgtop;
     accessors<OcGePoint3D> ucsorgbottom;
     accessors<OcGePoint3D> ucsorgleft;
     accessors<OcGePoint3D> ucsorgright;
     accessors<OcGePoint3D> ucsorgfront;
     accessors<OcGePoint3D> ucsorgback;
-    accessors<std::wstring> dimpost;
-    accessors<std::wstring> dimapost;
+    OC_DB_TEXT(dimpost);
+    OC_DB_TEXT(dimapost);
 
     // R13 - R14
     /*------------------- R13 - R14 ------------------*/
     //////////////////////////////////////////////////////////////////////////
-    accessors<bool> dimtol;
-    accessors<bool> dimlim;
-    accessors<bool> dimtih;
-    accessors<bool> dimtoh;
-    accessors<bool> dimse1;
-    accessors<bool> dimse2;
-    accessors<bool> dimalt;
-    accessors<bool> dimtofl;
-    accessors<bool> dimsah;
-    accessors<bool> dimtix;
-    accessors<bool> dimsoxd;
+    OC_DB_FLAG(dimtol);
+    OC_DB_FLAG(dimlim);
+    OC_DB_FLAG(dimtih);
+    OC_DB_FLAG(dimtoh);
+    OC_DB_FLAG(dimse1);
+    OC_DB_FLAG(dimse2);
+    OC_DB_FLAG(dimalt);
+    OC_DB_FLAG(dimtofl);
+    OC_DB_FLAG(dimsah);
+    OC_DB_FLAG(dimtix);
+    OC_DB_FLAG(dimsoxd);
 
     accessors<int16_t> dimaltd; // RC in R13-R14
     accessors<int16_t> dimzin; // RC in R13-R14
-    accessors<bool> dimsd1;
-    accessors<bool> dimsd2;
+    OC_DB_FLAG(dimsd1);
+    OC_DB_FLAG(dimsd2);
     accessors<int16_t> dimtolj; // RC in R13-R14
     accessors<int16_t> dimjust; // RC in R13-R14
     accessors<byte_t> dimfit;
-    accessors<bool> dimupt;
+    OC_DB_FLAG(dimupt);
     accessors<int16_t> dimtzin; // RC in R13-R14
     accessors<int16_t> dimaltz; // RC in R13-R14
     accessors<int16_t> dimalttz; // RC in R13-R14
@@ -413,7 +461,7 @@ public:
     accessors<int16_t> dimtdec;
     accessors<int16_t> dimaltu;
     accessors<int16_t> dimalttd;
-    accessors<OcDbObjectId> dimtxsty;
+    OC_DB_HANDLE(dimtxsty);
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
@@ -439,7 +487,7 @@ public:
     accessors<double>          dimfxl;
     accessors<double>          dimjogang;
     accessors<int16_t>         dimtfill;
-    accessors<OcCmColor>    dimtfillclr;
+    OC_DB_COLOR(dimtfillclr);
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
@@ -472,9 +520,9 @@ public:
     /*------------------- R13 - R14 ------------------*/
     // accessors<std::wstring>    dimpost;
     // accessors<std::wstring>    dimapost;
-    accessors<std::wstring>    dimblk;
-    accessors<std::wstring>    dimblk1;
-    accessors<std::wstring>    dimblk2;
+    OC_DB_TEXT(dimblk);
+    OC_DB_TEXT(dimblk1);
+    OC_DB_TEXT(dimblk2);
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
@@ -488,9 +536,9 @@ public:
 
 // common
     /*-------------------- Common --------------------*/
-    accessors<OcCmColor>    dimclrd;
-    accessors<OcCmColor>    dimclre;
-    accessors<OcCmColor>    dimclrt;
+    OC_DB_COLOR(dimclrd);
+    OC_DB_COLOR(dimclre);
+    OC_DB_COLOR(dimclrt);
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
@@ -516,21 +564,21 @@ public:
 
 // R2007+
     /*-------------------- R2007+ --------------------*/
-    accessors<bool>            dimfxlon;
+    OC_DB_FLAG(dimfxlon);
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
     // accessors<OcDbObjectId>    dimtxtsty;
-    accessors<OcDbObjectId>    dimldrblk;
-    accessors<OcDbObjectId>    dimblkId;
-    accessors<OcDbObjectId>    dimblk1Id;
-    accessors<OcDbObjectId>    dimblk2Id;
+    OC_DB_HANDLE(dimldrblk);
+    OC_DB_HANDLE(dimblkId);
+    OC_DB_HANDLE(dimblk1Id);
+    OC_DB_HANDLE(dimblk2Id);
 
 // R2007+
     /*-------------------- R2007+ --------------------*/
-    accessors<OcDbObjectId>    dimltype;
-    accessors<OcDbObjectId>    dimltex1;
-    accessors<OcDbObjectId>    dimltex2;
+    OC_DB_HANDLE(dimltype);
+    OC_DB_HANDLE(dimltex1);
+    OC_DB_HANDLE(dimltex2);
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
@@ -539,44 +587,44 @@ public:
 
 // common
     /*-------------------- Common --------------------*/
-    accessors<OcDbObjectId>    blockCtrlId;    // CONTROL OBJECT
-    accessors<OcDbObjectId>    layerCtrlId;    // CONTROL OBJECT
-    accessors<OcDbObjectId>    styleCtrlId;    // CONTROL OBJECT
-    accessors<OcDbObjectId>    linetypeCtrlId; // CONTROL OBJECT
-    accessors<OcDbObjectId>    viewCtrlId;     // CONTROL OBJECT
-    accessors<OcDbObjectId>    ucsCtrlId;      // CONTROL OBJECT
-    accessors<OcDbObjectId>    vportCtrlId;    // CONTROL OBJECT
-    accessors<OcDbObjectId>    appidCtrlId;    // CONTROL OBJECT
-    accessors<OcDbObjectId>    dimstyleCtrlId; // CONTROL OBJECT
+    OC_DB_HANDLE(blockCtrlId);    // CONTROL OBJECT
+    OC_DB_HANDLE(layerCtrlId);    // CONTROL OBJECT
+    OC_DB_HANDLE(styleCtrlId);    // CONTROL OBJECT
+    OC_DB_HANDLE(linetypeCtrlId); // CONTROL OBJECT
+    OC_DB_HANDLE(viewCtrlId);     // CONTROL OBJECT
+    OC_DB_HANDLE(ucsCtrlId);      // CONTROL OBJECT
+    OC_DB_HANDLE(vportCtrlId);    // CONTROL OBJECT
+    OC_DB_HANDLE(appidCtrlId);    // CONTROL OBJECT
+    OC_DB_HANDLE(dimstyleCtrlId); // CONTROL OBJECT
 
 // R13-R15
     /*------------------- R13 - R15 ------------------*/
-    accessors<OcDbObjectId>    viewport; // ENTITY HEADER CONTROL OBJECT
+    OC_DB_HANDLE(viewport); // ENTITY HEADER CONTROL OBJECT
 
 // common
     /*-------------------- Common --------------------*/
-    accessors<OcDbObjectId>    dictionaryGroupId;      // (ACAD_GROUP)
-    accessors<OcDbObjectId>    dictionaryMLineStyleId; // (ACAD_MLINESTYLE)
-    accessors<OcDbObjectId>    dictionaryNamedObjsId;   // (NAMED OBJECTS)
+    OC_DB_HANDLE(dictionaryGroupId);      // (ACAD_GROUP)
+    OC_DB_HANDLE(dictionaryMLineStyleId); // (ACAD_MLINESTYLE)
+    OC_DB_HANDLE(dictionaryNamedObjsId);  // (NAMED OBJECTS)
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
     accessors<int16_t>         tstackalign;
     accessors<int16_t>         tstacksize;
-    accessors<std::wstring>    hyperlinkbase;
-    accessors<std::wstring>    stylesheet;
-    accessors<OcDbObjectId>    dictionaryLayoutsId;   // (LAYOUTS)
-    accessors<OcDbObjectId>    dictionaryPlotSettingsId;   // (PLOTSETTINGS)
-    accessors<OcDbObjectId>    dictionaryPlotStylesId;   // (PLOTSTYLES)
+    OC_DB_TEXT(hyperlinkbase);
+    OC_DB_TEXT(stylesheet);
+    OC_DB_HANDLE(dictionaryLayoutsId);      // (LAYOUTS)
+    OC_DB_HANDLE(dictionaryPlotSettingsId); // (PLOTSETTINGS)
+    OC_DB_HANDLE(dictionaryPlotStylesId);   // (PLOTSTYLES)
 
 // R2004+
     /*-------------------- R2004+ --------------------*/
-    accessors<OcDbObjectId>    dictionaryMaterialsId;   // (MATERIALS)
-    accessors<OcDbObjectId>    dictionaryColorsId;   // (COLORS)
+    OC_DB_HANDLE(dictionaryMaterialsId); // (MATERIALS)
+    OC_DB_HANDLE(dictionaryColorsId);    // (COLORS)
 
 // R2007+
     /*-------------------- R2007+ --------------------*/
-    accessors<OcDbObjectId>    dictionaryVisualStyleId;   // (VISUALSTYLE)
+    OC_DB_HANDLE(dictionaryVisualStyleId); // (VISUALSTYLE)
 
 // R2000+
     /*-------------------- R2000+ --------------------*/
@@ -591,9 +639,9 @@ public:
 //                      OLESTARTUP      Flags & 0x4000
     accessors<int16_t>         insunits;
     accessors<int16_t>         cepsntype;
-    accessors<OcDbObjectId>    cpsnid;       // (present only if CEPSNTYPE == 3)
-    accessors<std::wstring>    fingerprintguid;
-    accessors<std::wstring>    versionguid;
+    OC_DB_HANDLE(cpsnid); // (present only if CEPSNTYPE == 3)
+    OC_DB_TEXT(fingerprintguid);
+    OC_DB_TEXT(versionguid);
 
 // R2004+
     /*-------------------- R2004+ --------------------*/
@@ -607,19 +655,19 @@ public:
     accessors<int16_t>         intersectioncolor;
     accessors<byte_t>          obscuredltype;
     accessors<byte_t>          intersectiondisplay;
-    accessors<std::wstring>    projectname;
+    OC_DB_TEXT(projectname);
 
 // common
     /*-------------------- Common --------------------*/
-    accessors<OcDbObjectId>    block_recordPsId;  // (*PAPER_SPACE)
-    accessors<OcDbObjectId>    block_recordMsId;  // (*MODEL_SPACE)
-    accessors<OcDbObjectId>    ltypeByLayerId;         // (BYLAYER)
-    accessors<OcDbObjectId>    ltypeByBlockId;         // (BYBLOCK)
-    accessors<OcDbObjectId>    ltypeContinuousId;         // (CONTINUOUS)
+    OC_DB_HANDLE(block_recordPsId);  // (*PAPER_SPACE)
+    OC_DB_HANDLE(block_recordMsId);  // (*MODEL_SPACE)
+    OC_DB_HANDLE(ltypeByLayerId);    // (BYLAYER)
+    OC_DB_HANDLE(ltypeByBlockId);    // (BYBLOCK)
+    OC_DB_HANDLE(ltypeContinuousId); // (CONTINUOUS)
 
 // R2007+
     /*-------------------- R2007+ --------------------*/
-    accessors<bool>            cameradisplay;
+    OC_DB_FLAG(cameradisplay);
     accessors<int32_t>         unknown21;
     accessors<int32_t>         unknown22;
     accessors<double>          unknown23;
@@ -646,11 +694,11 @@ public:
     accessors<byte_t>          tilemodelightsynch;
     accessors<byte_t>          dwfframe;
     accessors<byte_t>          dgnframe;
-    accessors<bool>            unknown47;
-    accessors<OcCmColor>    interferecolor;
-    accessors<OcDbObjectId>    interfereobjvsId;
-    accessors<OcDbObjectId>    interferevpvsId;
-    accessors<OcDbObjectId>    dragvsId;
+    OC_DB_FLAG(unknown47);
+    OC_DB_COLOR(interferecolor);
+    OC_DB_HANDLE(interfereobjvsId);
+    OC_DB_HANDLE(interferevpvsId);
+    OC_DB_HANDLE(dragvsId);
     accessors<byte_t>          cshadow;
     accessors<double>          unknown53;
 
@@ -666,7 +714,175 @@ public:
     accessors<uint16_t>        crc;      // for the data section, starting after the
     // sentinel. Use 0xC0C1 for the initial value.
 
-
+// no more packed members, keep the macros out of the including files
+#undef OC_DB_FLAG
+#undef OC_DB_TEXT
+#undef OC_DB_HANDLE_AS
+#undef OC_DB_HANDLE
+#undef OC_DB_HARD_HANDLE
+#undef OC_DB_COLOR
+
+private:
+    OcApp::ErrorStatus ReadDwg(std::unique_ptr<OcBsStreamIn> & pIn,
+                               OcDbDatabase::ReadMode mode);
+    static OcApp::ErrorStatus Probe(OcBsStreamIn & in, OcDbProbeInfo & info,
+                                    bool bHeaderVars);
+
+    // Declared ahead of the decoded sections, which refer to it.
+    OcDbStringPool m_strings;
+
+    // Storage behind the OC_DB_FLAG, OC_DB_TEXT, OC_DB_HANDLE and
+    // OC_DB_COLOR members.
+    enum
+    {
+        eFlag_dimaso,
+        eFlag_dimsho,
+        eFlag_dimsav,
+        eFlag_plinegen,
+        eFlag_orthomode,
+        eFlag_regenmode,
+        eFlag_fillmode,
+        eFlag_qtextmode,
+        eFlag_psltscale,
+        eFlag_limcheck,
+        eFlag_blipmode,
+        eFlag_undocumented,
+        eFlag_usertimer,
+        eFlag_skpoly,
+        eFlag_angdir,
+        eFlag_splframe,
+        eFlag_attreq,
+        eFlag_attdia,
+        eFlag_mirrtext,
+        eFlag_worldview,
+        eFlag_wireframe,
+        eFlag_tilemode,
+        eFlag_plimcheck,
+        eFlag_visretain,
+        eFlag_delobj,
+        eFlag_dispsilh,
+        eFlag_pellipse,
+        eFlag_dimtol,
+        eFlag_dimlim,
+        eFlag_dimtih,
+        eFlag_dimtoh,
+        eFlag_dimse1,
+        eFlag_dimse2,
+        eFlag_dimalt,
+        eFlag_dimtofl,
+        eFlag_dimsah,
+        eFlag_dimtix,
+        eFlag_dimsoxd,
+        eFlag_dimsd1,
+        eFlag_dimsd2,
+        eFlag_dimupt,
+        eFlag_dimfxlon,
+        eFlag_cameradisplay,
+        eFlag_unknown47,
+        numHeaderFlags
+    };
+
+    enum
+    {
+        eText_unknown5,
+        eText_unknown6,
+        eText_unknown7,
+        eText_unknown8,
+        eText_menuname,
+        eText_dimpost,
+        eText_dimapost,
+        eText_dimblk,
+        eText_dimblk1,
+        eText_dimblk2,
+        eText_hyperlinkbase,
+        eText_stylesheet,
+        eText_fingerprintguid,
+        eText_versionguid,
+        eText_projectname,
+        numHeaderTexts
+    };
+
+    enum
+    {
+        eHandle_currentVpId,
+        eHandle_handseed,
+        eHandle_clayer,
+        eHandle_textstyle,
+        eHandle_celtype,
+        eHandle_cmaterial,
+        eHandle_dimstyle,
+        eHandle_cmlstyle,
+        eHandle_pucsname,
+        eHandle_pucsbase,
+        eHandle_pucsorthoref,
+        eHandle_ucsname,
+        eHandle_ucsbase,
+        eHandle_ucsorthoref,
+        eHandle_dimtxsty,
+        eHandle_dimldrblk,
+        eHandle_dimblkId,
+        eHandle_dimblk1Id,
+        eHandle_dimblk2Id,
+        eHandle_dimltype,
+        eHandle_dimltex1,
+        eHandle_dimltex2,
+        eHandle_blockCtrlId,
+        eHandle_layerCtrlId,
+        eHandle_styleCtrlId,
+        eHandle_linetypeCtrlId,
+        eHandle_viewCtrlId,
+        eHandle_ucsCtrlId,
+        eHandle_vportCtrlId,
+        eHandle_appidCtrlId,
+        eHandle_dimstyleCtrlId,
+        eHandle_viewport,
+        eHandle_dictionaryGroupId,
+        eHandle_dictionaryMLineStyleId,
+        eHandle_dictionaryNamedObjsId,
+        eHandle_dictionaryLayoutsId,
+        eHandle_dictionaryPlotSettingsId,
+        eHandle_dictionaryPlotStylesId,
+        eHandle_dictionaryMaterialsId,
+        eHandle_dictionaryColorsId,
+        eHandle_dictionaryVisualStyleId,
+        eHandle_cpsnid,
+        eHandle_block_recordPsId,
+        eHandle_block_recordMsId,
+        eHandle_ltypeByLayerId,
+        eHandle_ltypeByBlockId,
+        eHandle_ltypeContinuousId,
+        eHandle_interfereobjvsId,
+        eHandle_interferevpvsId,
+        eHandle_dragvsId,
+        numHeaderHandles
+    };
+
+    enum
+    {
+        eColor_cecolor,
+        eColor_dimtfillclr,
+        eColor_dimclrd,
+        eColor_dimclre,
+        eColor_dimclrt,
+        eColor_interferecolor,
+        numHeaderColors
+    };
+
+    void ClearHeaderVars(void);
+
+    std::bitset<numHeaderFlags> m_flags;
+    OcDbStringPool::Id m_text[numHeaderTexts];
+    int64_t m_handles[numHeaderHandles];
+    uint64_t m_colors[numHeaderColors];
+
+    // Kept after reading so objects can be looked up, and with eReadLazy
+    // decoded, later. m_pStream is only kept for eReadLazy.
+    std::unique_ptr<OcBsStreamIn> m_pStream;
+    std::unique_ptr<OcBsDwgClasses> m_pClasses;
+    std::unique_ptr<OcBsDwgObjectMap> m_pObjMap;
+    OcDbReadStats m_readStats;
+    int m_nDecodeThreads;
+    OcDbDatabase::FileAccess m_fileAccess;
 };
 
 END_OCTAVARIUM_NS
@@ -0,0 +1,161 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include <stdexcept>
+#include "OcCommon.h"
+#include "OcDbStringPool.h"
+
+BEGIN_OCTAVARIUM_NS
+
+OcDbStringPool::OcDbStringPool(void)
+    : m_numBlocks(0)
+{
+    VLOG_FUNC_NAME;
+}
+
+OcDbStringPool::~OcDbStringPool(void)
+{
+    VLOG_FUNC_NAME;
+}
+
+OcDbStringPool::Id OcDbStringPool::Intern(const std::wstring & str)
+{
+    VLOG_FUNC_NAME;
+
+    if(str.empty())
+    {
+        return emptyId;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(&str);
+
+    if(it != m_ids.end())
+    {
+        return it->second;
+    }
+
+    Id id = (Id) m_strings.size() + 1;
+    CHECK(id < MAXBLOCKS * BLOCKSIZE) << "String pool is full";
+    m_strings.push_back(str);
+    m_ids.insert(std::make_pair(&m_strings.back(), id));
+    SetSlot(id, &m_strings.back());
+    return id;
+}
+
+OcDbStringPool::Id OcDbStringPool::Find(const std::wstring & str) const
+{
+    VLOG_FUNC_NAME;
+
+    if(str.empty())
+    {
+        return emptyId;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(&str);
+    return it != m_ids.end() ? it->second : npos;
+}
+
+const std::wstring & OcDbStringPool::String(Id id) const
+{
+    VLOG_FUNC_NAME;
+
+    if(id == emptyId)
+    {
+        return m_empty;
+    }
+
+    const std::wstring * const * pBlock =
+        (id >> BLOCKBITS) < m_numBlocks.load(std::memory_order_acquire) ?
+        m_blocks[id >> BLOCKBITS].get() : nullptr;
+    const std::wstring * pStr = pBlock ? pBlock[id & (BLOCKSIZE - 1)] : nullptr;
+
+    if(!pStr)
+    {
+        throw std::out_of_range("OcDbStringPool::String");
+    }
+
+    return *pStr;
+}
+
+size_t OcDbStringPool::Size(void) const
+{
+    VLOG_FUNC_NAME;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strings.size() + 1;
+}
+
+void OcDbStringPool::Clear(void)
+{
+    VLOG_FUNC_NAME;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ids.clear();
+    m_strings.clear();
+    m_numBlocks.store(0, std::memory_order_release);
+    m_blocks.clear();
+}
+
+void OcDbStringPool::SetSlot(Id id, const std::wstring * pStr)
+{
+    VLOG_FUNC_NAME;
+    Id numBlocks = m_numBlocks.load(std::memory_order_relaxed);
+
+    if((id >> BLOCKBITS) == numBlocks)
+    {
+        // String may be reading the table, it must not reallocate
+        if(m_blocks.capacity() < MAXBLOCKS)
+        {
+            m_blocks.reserve(MAXBLOCKS);
+        }
+
+        m_blocks.push_back(Block(new const std::wstring *[BLOCKSIZE]()));
+        m_blocks.back()[id & (BLOCKSIZE - 1)] = pStr;
+        m_numBlocks.store(numBlocks + 1, std::memory_order_release);
+        return;
+    }
+
+    m_blocks[id >> BLOCKBITS][id & (BLOCKSIZE - 1)] = pStr;
+}
+
+END_OCTAVARIUM_NS
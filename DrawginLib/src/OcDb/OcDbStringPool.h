@@ -0,0 +1,142 @@
+/**
+ *	@file
+ *  @brief Defines OcDbStringPool class
+ *
+ *  Interned strings shared by the objects of a database
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_OCTAVARIUM_NS
+
+/**
+ *  Interns strings read from a drawing. Each distinct string is stored
+ *  once and handed out as a small integer id, so names that repeat across
+ *  many objects cost one id each and compare as integers. Strings are
+ *  never removed, references returned by String stay valid until the pool
+ *  is cleared or destroyed. Safe to use from several decoding threads,
+ *  only Intern and Find take a lock. The id table is not allocated
+ *  until the first non-empty string is interned.
+ */
+class OcDbStringPool
+{
+    DISABLE_COPY(OcDbStringPool);
+public:
+    typedef uint32_t Id;
+
+    // id of the empty string, which is always in the pool
+    static const Id emptyId = 0;
+    // returned by Find for strings that are not in the pool
+    static const Id npos = 0xffffffff;
+
+    OcDbStringPool(void);
+    ~OcDbStringPool(void);
+
+    /**
+     *  Returns the id of str, adding it to the pool if it is not there.
+     */
+    Id Intern(const std::wstring & str);
+
+    /**
+     *  Returns the id of str, or npos when it has not been interned.
+     */
+    Id Find(const std::wstring & str) const;
+
+    /**
+     *  Returns the string of id without locking, so the getters of
+     *  interned names cost an array lookup. Throws std::out_of_range for
+     *  ids the pool has not handed out.
+     */
+    const std::wstring & String(Id id) const;
+    size_t Size(void) const;
+    void Clear(void);
+
+private:
+    struct Hash
+    {
+        size_t operator()(const std::wstring * pStr) const
+        {
+            return std::hash<std::wstring>()(*pStr);
+        }
+    };
+
+    struct Equal
+    {
+        bool operator()(const std::wstring * pLhs, const std::wstring * pRhs) const
+        {
+            return *pLhs == *pRhs;
+        }
+    };
+
+    typedef std::unique_ptr<const std::wstring *[]> Block;
+
+    void SetSlot(Id id, const std::wstring * pStr);
+
+    // room for 16M distinct strings
+    static const int BLOCKBITS = 12;
+    static const Id BLOCKSIZE = 1 << BLOCKBITS;
+    static const Id MAXBLOCKS = 4096;
+
+    mutable std::mutex m_mutex;
+    // returned for emptyId, which has no slot
+    const std::wstring m_empty;
+    // the strings of ids 1 and up, a deque so they never move
+    std::deque<std::wstring> m_strings;
+    // keys point into m_strings
+    std::unordered_map<const std::wstring *, Id, Hash, Equal> m_ids;
+    // Pointers into m_strings by id, for String. The table is reserved to
+    // MAXBLOCKS when the first block is added so it never reallocates,
+    // blocks never move, and a slot is written once, before its id is
+    // handed out. m_numBlocks is stored after a block is added, so String
+    // reads the table without locking.
+    std::vector<Block> m_blocks;
+    std::atomic<Id> m_numBlocks;
+};
+
+END_OCTAVARIUM_NS
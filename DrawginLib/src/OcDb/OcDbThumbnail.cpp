@@ -0,0 +1,174 @@
+/**
+ *	@file
+ */
+
+/****************************************************************************
+**
+** This file is part of DrawGin library. A C++ framework to read and
+** write .dwg files formats.
+**
+** Copyright (C) 2011, 2012, 2013 Paul Kohut.
+** All rights reserved.
+** Author: Paul Kohut (pkohut2@gmail.com)
+**
+** DrawGin library is free software; you can redistribute it and/or
+** modify it under the terms of either:
+**
+**   * the GNU Lesser General Public License as published by the Free
+**     Software Foundation; either version 3 of the License, or (at your
+**     option) any later version.
+**
+**   * the GNU General Public License as published by the free
+**     Software Foundation; either version 2 of the License, or (at your
+**     option) any later version.
+**
+** or both in parallel, as here.
+**
+** DrawGin library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; if not, write to the Free Software
+** Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** DrawGin project hosted at: http://code.google.com/p/drawgin/
+**
+** Authors:
+**      pk          Paul Kohut <pkohut2@gmail.com>
+**
+****************************************************************************/
+
+
+#include "OcCommon.h"
+#include "OcError.h"
+#include "OcDbThumbnail.h"
+#include "..\OcBs\OcBsStreamIn.h"
+#include "..\OcBs\OcBsDwgFileHeader.h"
+#include "..\OcBs\OcBsDwgPreviewImage.h"
+
+BEGIN_OCTAVARIUM_NS
+
+class OcDbThumbnailPrivate
+{
+    DISABLE_COPY(OcDbThumbnailPrivate);
+
+public:
+    OcDbThumbnailPrivate(void) {}
+
+    OcApp::ErrorStatus Read(OcBsStreamIn & in);
+
+    // kept open, the image data points into its mapping
+    std::unique_ptr<OcBsStreamIn> m_pStream;
+    OcBsDwgPreviewImage m_image;
+};
+
+OcApp::ErrorStatus OcDbThumbnailPrivate::Read(OcBsStreamIn & in)
+{
+    VLOG_FUNC_NAME;
+    OcBsDwgFileHeader dwgHdr;
+    OcApp::ErrorStatus es = dwgHdr.ReadDwg(in);
+    if(es != OcApp::eOk)
+    {
+        LOG(ERROR) << "Error processing drawing file header";
+        return es;
+    }
+
+    if(!dwgHdr.IsR13c3OrHigher())
+    {
+        return OcApp::eNotFound;
+    }
+
+    in.Seek(dwgHdr.ImageSeeker());
+    es = m_image.ReadDwg(in);
+    if(es != OcApp::eOk)
+    {
+        LOG(ERROR) << "Error processing image data";
+    }
+    return es;
+}
+
+OcDbThumbnail::OcDbThumbnail(void)
+    : m_pImpl(new OcDbThumbnailPrivate)
+{
+    VLOG_FUNC_NAME;
+}
+
+OcDbThumbnail::~OcDbThumbnail(void)
+{
+    VLOG_FUNC_NAME;
+}
+
+OcApp::ErrorStatus OcDbThumbnail::Read(const std::string & sFilename)
+{
+    VLOG_FUNC_NAME;
+    std::unique_ptr<OcDbThumbnailPrivate> pImpl(new OcDbThumbnailPrivate);
+    pImpl->m_pStream.reset(new OcBsStreamIn);
+    OcBsStreamIn & in = *pImpl->m_pStream;
+
+    in.Open(sFilename, OcBsStream::eMemoryMapped);
+    if(!in)
+    {
+        VLOG(4) << "Memory mapping failed, reading through file stream";
+        in.Close();
+        in.Open(sFilename);
+    }
+
+    OcApp::ErrorStatus es = in ? pImpl->Read(in) : OcApp::eOpeningFile;
+
+    // nothing of a failed read is kept, so the sizes are all 0
+    m_pImpl = (es == OcApp::eOk) ? std::move(pImpl)
+                                 : std::unique_ptr<OcDbThumbnailPrivate>(new OcDbThumbnailPrivate);
+    return es;
+}
+
+OcApp::ErrorStatus OcDbThumbnail::Read(const uint8_t * data, size_t len)
+{
+    VLOG_FUNC_NAME;
+    std::unique_ptr<OcDbThumbnailPrivate> pImpl(new OcDbThumbnailPrivate);
+    OcBsStreamIn in(data, len);
+    OcApp::ErrorStatus es = in ? pImpl->Read(in) : OcApp::eOpeningFile;
+
+    m_pImpl = (es == OcApp::eOk) ? std::move(pImpl)
+                                 : std::unique_ptr<OcDbThumbnailPrivate>(new OcDbThumbnailPrivate);
+    return es;
+}
+
+const uint8_t * OcDbThumbnail::BmpData(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_image.BmpData().pData;
+}
+
+size_t OcDbThumbnail::BmpSize(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_image.BmpData().size;
+}
+
+const uint8_t * OcDbThumbnail::WmfData(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_image.WmfData().pData;
+}
+
+size_t OcDbThumbnail::WmfSize(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_image.WmfData().size;
+}
+
+const uint8_t * OcDbThumbnail::HeaderData(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_image.HeaderData().pData;
+}
+
+size_t OcDbThumbnail::HeaderSize(void) const
+{
+    VLOG_FUNC_NAME;
+    return m_pImpl->m_image.HeaderData().size;
+}
+
+END_OCTAVARIUM_NS